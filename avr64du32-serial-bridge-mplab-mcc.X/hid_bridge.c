@@ -0,0 +1,134 @@
+#include "hid_bridge.h"
+
+#include "serial_bus.h"
+#include "usb_timestamp.h"
+#include "usb_config.h"
+#if USB_HID_ENABLE
+#include "usb_hid.h"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if USB_HID_ENABLE
+static uint8_t request[USB_HID_REPORT_SIZE];
+static uint8_t response[USB_HID_REPORT_SIZE];
+
+//Offset of the data in the response, after the header and the timestamp
+#define HID_BRIDGE_DATA_OFFSET (3 + USB_TIMESTAMP_SIZE)
+
+//Runs one request, the data read is placed at HID_BRIDGE_DATA_OFFSET of the response
+static uint8_t HIDBridge_Run(uint8_t operation, uint8_t target, uint8_t reg, uint8_t length)
+{
+    uint8_t* data = &response[HID_BRIDGE_DATA_OFFSET];
+
+    if (length > HID_BRIDGE_MAX_LENGTH)
+    {
+        return HID_BRIDGE_STATUS_INVALID;
+    }
+
+    switch (operation)
+    {
+        case HID_BRIDGE_I2C_READ:
+        {
+            if ((length == 0) || (target > 0x7F))
+            {
+                return HID_BRIDGE_STATUS_INVALID;
+            }
+            return SerialBus_I2CWriteRead(target, &reg, 1, data, length);
+        }
+        case HID_BRIDGE_I2C_WRITE:
+        {
+            if (target > 0x7F)
+            {
+                return HID_BRIDGE_STATUS_INVALID;
+            }
+
+            //Register, then the data, from the timestamp on as nothing is read back
+            data = &response[3];
+            data[0] = reg;
+            for (uint8_t i = 0; i < length; i++)
+            {
+                data[i + 1] = request[4 + i];
+            }
+            return SerialBus_I2CWrite(target, data, length + 1);
+        }
+        case HID_BRIDGE_SPI_READ:
+        {
+            if ((length == 0) || (target > SPI_TARGET_USD))
+            {
+                return HID_BRIDGE_STATUS_INVALID;
+            }
+
+            //Command byte in the timestamp, then 0x00 while the response is clocked in
+            data[-1] = reg;
+            for (uint8_t i = 0; i < length; i++)
+            {
+                data[i] = 0x00;
+            }
+            SerialBus_SPIExchange((spi_target_t) target, &data[-1], length + 1);
+            return BUS_OK;
+        }
+        case HID_BRIDGE_SPI_EXCHANGE:
+        {
+            if ((length == 0) || (target > SPI_TARGET_USD))
+            {
+                return HID_BRIDGE_STATUS_INVALID;
+            }
+
+            for (uint8_t i = 0; i < length; i++)
+            {
+                data[i] = request[4 + i];
+            }
+            SerialBus_SPIExchange((spi_target_t) target, data, length);
+            return BUS_OK;
+        }
+        default:
+        {
+            //Unknown operation
+            return HID_BRIDGE_STATUS_INVALID;
+        }
+    }
+}
+#endif
+
+void HIDBridge_Handle(void)
+{
+#if USB_HID_ENABLE
+    usb_timestamp_t stamp;
+    
+    //The response needs the input report, so the next request waits until it is free
+    if ((!USB_HIDInputReportIsFree()) || (!USB_HIDOutputReportRead(request)))
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < USB_HID_REPORT_SIZE; i++)
+    {
+        response[i] = 0x00;
+    }
+
+    response[0] = request[0];
+    response[1] = HIDBridge_Run(request[0], request[1], request[2], request[3]);
+    SerialBus_GetTimestamp(&stamp);
+    
+    //Reads return the data, writes only the status
+    if ((response[1] == BUS_OK) && (request[0] != HID_BRIDGE_I2C_WRITE))
+    {
+        response[2] = request[3];
+    }
+    else
+    {
+        response[2] = 0;
+        for (uint8_t i = 3; i < USB_HID_REPORT_SIZE; i++)
+        {
+            response[i] = 0x00;
+        }
+    }
+    
+    //Written last, the I2C write and the SPI read use its bytes
+    USBTimestamp_Write(&stamp, &response[3]);
+
+    USB_HIDInputReportWrite(response);
+#endif
+}
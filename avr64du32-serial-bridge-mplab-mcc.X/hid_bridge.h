@@ -0,0 +1,34 @@
+#ifndef HID_BRIDGE_H
+#define	HID_BRIDGE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Bridge operations sent in the HID output reports, one 64-byte report per request
+//Request:  [operation][address or SPI target][register or command][length][data]
+//Response: [operation][status][length][timestamp][data], sent in the next input report
+//The timestamp is the USB frame and the microseconds into it when the transaction completed, 2 bytes each, LSB first
+#define HID_BRIDGE_I2C_READ 0x10        //Reads LENGTH bytes from the register
+#define HID_BRIDGE_I2C_WRITE 0x11       //Writes LENGTH bytes after the register
+#define HID_BRIDGE_SPI_READ 0x12        //Sends the command, then clocks in LENGTH bytes
+#define HID_BRIDGE_SPI_EXCHANGE 0x13    //Exchanges LENGTH bytes with one chip select, the response holds the bytes clocked in
+
+//Response status of an unknown operation or an invalid parameter, other values are bus_status_t
+#define HID_BRIDGE_STATUS_INVALID 0xFF
+
+//Largest LENGTH, the response data less the 7 header bytes
+#define HID_BRIDGE_MAX_LENGTH 57
+
+    //Runs the next request from the HID interface, once the last response has been sent
+    void HIDBridge_Handle(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HID_BRIDGE_H */
+
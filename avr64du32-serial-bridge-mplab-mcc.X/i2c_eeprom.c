@@ -0,0 +1,87 @@
+#include "i2c_eeprom.h"
+
+#include "serial_bus.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//Memory address followed by one page of data
+static uint8_t packet[I2C_EEPROM_MAX_ADDR_LENGTH + I2C_EEPROM_MAX_PAGE_SIZE];
+
+//Waits for the EEPROM to acknowledge its address after a write cycle
+static bus_status_t I2CEEPROM_WaitForReady(uint8_t addr)
+{
+    bus_status_t status = BUS_NOT_READY;
+    
+    //The EEPROM NACKs its address until the write cycle is complete
+    SerialBus_I2CExpectAddrNack(true);
+    
+    for (uint16_t i = 0; i < I2C_EEPROM_ACK_POLL_LIMIT; i++)
+    {
+        status = SerialBus_I2CWrite(addr, NULL, 0);
+        
+        if (status != BUS_ADDR_NACK)
+        {
+            break;
+        }
+    }
+    
+    SerialBus_I2CExpectAddrNack(false);
+    
+    return (status == BUS_ADDR_NACK) ? BUS_NOT_READY : status;
+}
+
+//Programs LEN bytes of DATA into the I2C EEPROM at ADDR, starting at MEMADDR
+bus_status_t I2CEEPROM_Program(uint8_t addr, uint16_t memAddr, uint8_t addrLen, uint8_t pageSize, uint8_t* data, uint8_t len)
+{
+    if ((addrLen == 0) || (addrLen > I2C_EEPROM_MAX_ADDR_LENGTH) 
+            || (pageSize == 0) || (pageSize > I2C_EEPROM_MAX_PAGE_SIZE))
+    {
+        return BUS_ERROR;
+    }
+    
+    bus_status_t status = BUS_OK;
+    
+    while ((len > 0) && (status == BUS_OK))
+    {
+        //Bytes left until the end of the current page
+        uint8_t chunk = pageSize - (memAddr % pageSize);
+        
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+        
+        //Load the memory address (MSB first)
+        if (addrLen == 2)
+        {
+            packet[0] = memAddr >> 8;
+            packet[1] = memAddr & 0xFF;
+        }
+        else
+        {
+            packet[0] = memAddr & 0xFF;
+        }
+        
+        //Load the page data
+        for (uint8_t i = 0; i < chunk; i++)
+        {
+            packet[addrLen + i] = data[i];
+        }
+        
+        status = SerialBus_I2CWrite(addr, packet, addrLen + chunk);
+        
+        if (status == BUS_OK)
+        {
+            //Start the next page as soon as the write cycle finishes
+            status = I2CEEPROM_WaitForReady(addr);
+        }
+        
+        data += chunk;
+        memAddr += chunk;
+        len -= chunk;
+    }
+    
+    return status;
+}
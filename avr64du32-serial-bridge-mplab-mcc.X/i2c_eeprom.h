@@ -0,0 +1,37 @@
+#ifndef I2C_EEPROM_H
+#define	I2C_EEPROM_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "serial_bus.h"
+
+//Largest page (in bytes) that can be written in a single transaction
+#define I2C_EEPROM_MAX_PAGE_SIZE 64
+
+//Largest memory address field (in bytes) supported
+#define I2C_EEPROM_MAX_ADDR_LENGTH 2
+
+//Number of address-only probes to wait for a write cycle to finish
+//Each probe is ~100 us at 100 kHz
+#define I2C_EEPROM_ACK_POLL_LIMIT 500
+
+    /*
+     * Programs LEN bytes of DATA into the I2C EEPROM at ADDR, starting at MEMADDR.
+     * 
+     * The data is split on PAGESIZE boundaries. After each page, the EEPROM
+     * is ACK polled until it finishes its internal write cycle.
+     * ADDRLEN is the size of the memory address field (1 or 2 bytes).
+     * 
+     * Returns BUS_NOT_READY if the EEPROM did not finish a write cycle in time.
+     */
+    bus_status_t I2CEEPROM_Program(uint8_t addr, uint16_t memAddr, uint8_t addrLen, uint8_t pageSize, uint8_t* data, uint8_t len);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* I2C_EEPROM_H */
+
@@ -37,9 +37,31 @@
 #include "mcc_generated_files/system/system.h"
 #include "usb_core.h"
 #include "usb_cdc_virtual_serial_port.h"
+#include "usb_functions.h"
+#if USB_VENDOR_ENABLE
+#include "usb_vendor.h"
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+#include "usb_cdc_data_port.h"
+#endif
+#if USB_HID_ENABLE
+#include "usb_hid.h"
+#endif
 
 #include "text_queue.h"
 #include "text_parser.h"
+#include "serial_bus.h"
+#include "timebase.h"
+#include "uart_bridge.h"
+#include "usart0.h"
+#include "usb_recovery.h"
+#include "usb_timestamp.h"
+#include "vbus.h"
+#include "scheduler.h"
+#include "vendor_requests.h"
+#include "hid_bridge.h"
+#include "profiler.h"
+#include "trace.h"
 
 #define USB_MAX_RETRIES 10
 
@@ -47,21 +69,340 @@ typedef enum {
     USB_ERROR = -1, USB_DISCONNECTED = 0, USB_READY
 } usb_state_t;
 
+static usb_state_t usbState = USB_DISCONNECTED;
+static uint8_t retries = 0;
+
+//Lets the stack interrupt again, the SOF interrupt anchors the transaction timestamps
+static void Main_USBInterruptEnable(void)
+{
+    USB0.INTCTRLA = USB_SOF_bm | USB_SUSPEND_bm | USB_RESUME_bm | USB_RESET_bm | USB_STALLED_bm | USB_UNF_bm | USB_OVF_bm;
+    USB0.INTCTRLB = USB_SETUP_bm | USB_TRNCOMPL_bm;
+}
+
+//Masks all USB interrupts, the flags are kept for the stack
+static void Main_USBInterruptDisable(void)
+{
+    USB0.INTCTRLA = 0x0;
+    USB0.INTCTRLB = 0x0;
+}
+
+//Called from the USB interrupts, the stack itself runs in the USB task
+static void Main_USBInterrupt(void)
+{
+    //The flags stay set until the stack handles them, so mask the interrupts until then
+    //The SOF stays enabled, its flag is cleared by the bus event interrupt
+    USB0.INTCTRLA = USB_SOF_bm;
+    USB0.INTCTRLB = 0x0;
+    Scheduler_Post(SCHEDULER_EVENT_USB);
+}
+
+//Called from the USB bus event interrupt, the SOF is timed and taken before the stack runs
+static void Main_USBBusEvent(void)
+{
+    if (USB0.INTFLAGSA & USB_SOF_bm)
+    {
+        USBTimestamp_StartOfFrame();
+        USB0.INTFLAGSA = USB_SOF_bm;
+
+        //The USB task passes it on to the vendor stream
+        Scheduler_Post(SCHEDULER_EVENT_SOF);
+    }
+
+    //Any other enabled bus event is for the stack
+    if (USB0.INTFLAGSA & USB0.INTCTRLA & ~USB_SOF_bm)
+    {
+        Main_USBInterrupt();
+    }
+}
+
+//Follows VBUS and starts, or restarts, the USB stack
+static void Main_StateTask(uint8_t events)
+{
+    if (events & SCHEDULER_EVENT_TICK)
+    {
+        //Scheduled callbacks
+        Timebase_Task();
+    }
+    
+    //VBUS changes from the AC0 interrupt
+    if (VBUS_GetEvent() == VBUS_EVENT_DETACH)
+    {
+        if (usbState != USB_DISCONNECTED)
+        {
+            //VBUS is disconnected
+            usbState = USB_DISCONNECTED;
+            Main_USBInterruptDisable();
+            USB_Stop();
+
+            //Return to the text parser
+            UARTBridge_Stop();
+        }
+
+        //Reset retries count
+        retries = 0;
+    }
+
+    switch (usbState)
+    {
+        case USB_DISCONNECTED:
+        {
+            NANO_LED0_SetLow();
+            if (VBUS_IsPresent())
+            {
+                //VBUS
+                if (USB_Start() == SUCCESS)
+                {
+                    //USB is Ready
+                    usbState = USB_READY;
+                    retries = 0;
+
+                    //Drop any error left from the last connection
+                    USBDevice_StatusClear();
+                    Scheduler_Post(SCHEDULER_EVENT_USB);
+                }
+                else if (retries == USB_MAX_RETRIES)
+                {
+                    usbState = USB_ERROR;
+                }
+                else
+                {
+                    retries++;
+                }
+            }
+            break;
+        }
+        case USB_READY:
+        {
+            //VBUS is still connected
+            NANO_LED0_SetHigh();
+            break;
+        }
+        case USB_ERROR:
+        {
+            //USB Error
+            NANO_LED0_SetLow();
+
+            if (USBRecovery_ResetTask())
+            {
+                //Stack restarted, the host enumerates the device again
+                usbState = USB_READY;
+                Scheduler_Post(SCHEDULER_EVENT_USB);
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+//Runs the USB stack, the CDC Class Interfaces, the vendor interface and the HID interface
+static void Main_USBTask(uint8_t events)
+{
+    RETURN_CODE_t cdcStatus, deviceStatus, vendorStatus = SUCCESS, cdcDataStatus = SUCCESS, hidStatus = SUCCESS;
+
+    if (usbState != USB_READY)
+    {
+        return;
+    }
+
+    PROFILER_START(PROFILER_USB_TASK);
+
+    //Handle USB Traffic
+    PROFILER_START(PROFILER_USB_DEVICE);
+    deviceStatus = USBDevice_Handle();
+    PROFILER_STOP(PROFILER_USB_DEVICE);
+    if (deviceStatus != SUCCESS)
+    {
+        if (!USBRecovery_HandleError(USB_RECOVERY_SOURCE_DEVICE, deviceStatus))
+        {
+            usbState = USB_ERROR;
+        }
+    }
+
+    //Run the CDC Class Interface
+    cdcStatus = USB_CDCVirtualSerialPortHandler();
+    if (cdcStatus != SUCCESS)
+    {
+        //Recoverable errors only reset the CDC pipes
+        if (!USBRecovery_HandleError(USB_RECOVERY_SOURCE_CDC, cdcStatus))
+        {
+            usbState = USB_ERROR;
+        }
+    }
+
+#if USB_CDC_DATA_PORT_ENABLE
+    //Run the CDC data port
+    cdcDataStatus = USB_CDCDataPortHandler();
+    if (cdcDataStatus != SUCCESS)
+    {
+        if (!USBRecovery_HandleError(USB_RECOVERY_SOURCE_CDC_DATA, cdcDataStatus))
+        {
+            usbState = USB_ERROR;
+        }
+    }
+#endif
+
+#if USB_VENDOR_ENABLE
+#if USB_VENDOR_STREAM_ENABLE
+    //The SOF never reaches the stack, it is taken by the bus event interrupt
+    if (events & SCHEDULER_EVENT_SOF)
+    {
+        USB_VendorStreamStartOfFrame();
+    }
+#endif
+
+    //Run the vendor interface loopback
+    vendorStatus = USB_VendorHandler();
+    if (vendorStatus != SUCCESS)
+    {
+        if (!USBRecovery_HandleError(USB_RECOVERY_SOURCE_VENDOR, vendorStatus))
+        {
+            usbState = USB_ERROR;
+        }
+    }
+#endif
+
+#if USB_HID_ENABLE
+    //Run the HID interface
+    hidStatus = USB_HIDHandler();
+    if (hidStatus != SUCCESS)
+    {
+        if (!USBRecovery_HandleError(USB_RECOVERY_SOURCE_HID, hidStatus))
+        {
+            usbState = USB_ERROR;
+        }
+    }
+#endif
+
+    PROFILER_STOP(PROFILER_USB_TASK);
+
+    if (usbState != USB_READY)
+    {
+        //The state task resets the stack
+        return;
+    }
+
+    if ((cdcStatus == SUCCESS) && (deviceStatus == SUCCESS) && (vendorStatus == SUCCESS) && (cdcDataStatus == SUCCESS) 
+            && (hidStatus == SUCCESS))
+    {
+        USBRecovery_Clean();
+    }
+
+    //Let the stack interrupt again
+    Main_USBInterruptEnable();
+
+    if (events & SCHEDULER_EVENT_USB)
+    {
+        //Data or line state may have changed
+        Scheduler_Post(SCHEDULER_EVENT_RX);
+    }
+}
+
+//Runs the text parser, or the USART bridge
+static void Main_ApplicationTask(uint8_t events)
+{
+    if (usbState != USB_READY)
+    {
+        return;
+    }
+
+#if USB_CDC_DATA_PORT_ENABLE
+    //The bridge has the data port to itself, the command port stays with the text parser
+    if (UARTBridge_Handle())
+    {
+        //Come back while full blocks are moving, the tick or the USB stack picks up the rest
+        Scheduler_Post(SCHEDULER_EVENT_UART);
+    }
+    
+    PROFILER_START(PROFILER_TEXT_PARSER);
+    TextParser_Handle();
+    PROFILER_STOP(PROFILER_TEXT_PARSER);
+    TextQueue_LoadTransmitBuffer();
+#else
+    if (UARTBridge_IsActive())
+    {
+        //Forward data between USB and the USART, come back while full blocks are moving
+        if (UARTBridge_Handle())
+        {
+            Scheduler_Post(SCHEDULER_EVENT_UART);
+        }
+    }
+    else
+    {
+        //Process any text received
+        PROFILER_START(PROFILER_TEXT_PARSER);
+        TextParser_Handle();
+        PROFILER_STOP(PROFILER_TEXT_PARSER);
+
+        //Load in any text to transmit
+        TextQueue_LoadTransmitBuffer();
+    }
+#endif
+
+    //Answer HID requests whichever port is busy
+    HIDBridge_Handle();
+
+    //Start the USB transfers for the new data
+    Scheduler_Post(SCHEDULER_EVENT_USB_TX);
+}
+
 int main(void)
 {
     SYSTEM_Initialize();
     
+    //Init the USB functions next to the CDC command port
+    USBFunctions_Initialize();
+    
+    //Init Event Scheduler
+    Scheduler_Initialize();
+    
+    //Init 1 ms Tick
+    Timebase_Initialize();
+    
+    //Init I2C Bus Settings
+    SerialBus_Initialize();
+    
     //Init Text Queue
     TextQueue_Initialize();
     
     //Init Text Processor
     TextParser_Initialize();
     
+    //Init USART Bridge
+    UARTBridge_Initialize();
+    
+#if PROFILER_ENABLE
+    //Init Profiler
+    Profiler_Initialize();
+#endif
+    
+#if TRACE_ENABLE
+    //Init Event Trace
+    Trace_Initialize();
+#endif
+    
+    //Init USB Error Recovery
+    USBRecovery_Initialize();
+    
+    //Init Bus Vendor Requests
+    VendorRequests_Initialize();
+    
+    //Init VBUS Detection (AC0 interrupt)
+    VBUS_Initialize();
+    
     //Board configuration
     SPI0_Open(BOARD_CONFIG);
-
-    usb_state_t usbState = USB_DISCONNECTED;    
-    uint8_t retries = 0;
+    
+    //The USB interrupts only post events
+    USB0_TrnComplCallbackRegister(&Main_USBInterrupt);
+    USB0_BusEventCallbackRegister(&Main_USBBusEvent);
+    
+    //Tasks in priority order
+    Scheduler_AddTask(SCHEDULER_EVENT_VBUS | SCHEDULER_EVENT_TICK, &Main_StateTask);
+    Scheduler_AddTask(SCHEDULER_EVENT_USB | SCHEDULER_EVENT_USB_TX | SCHEDULER_EVENT_SOF, &Main_USBTask);
+    Scheduler_AddTask(SCHEDULER_EVENT_RX | SCHEDULER_EVENT_UART, &Main_ApplicationTask);
     
     if (AC0_Read())
     {
@@ -73,82 +414,7 @@ int main(void)
     
     while(1)
     {
-        switch (usbState)
-        {
-            case USB_DISCONNECTED:
-            {
-                NANO_LED0_SetLow();
-                if (AC0_Read())
-                {
-                    //VBUS
-                    if (USB_Start() == SUCCESS)
-                    {
-                        //USB is Ready
-                        usbState = USB_READY;
-                        retries = 0;
-                    }
-                    else if (retries == USB_MAX_RETRIES)
-                    {
-                        usbState = USB_ERROR;
-                    }
-                    else
-                    {
-                        retries++;
-                    }
-                }
-                break;
-            }
-            case USB_READY:
-            {
-                if (!AC0_Read())
-                {
-                    //VBUS is disconnected
-                    usbState = USB_DISCONNECTED;
-                    
-                    //Reset retries count
-                    retries = 0;
-                }
-                else
-                {
-                    //VBUS is still connected
-                    NANO_LED0_SetHigh();
-                    
-                    //Process any text received
-                    TextParser_Handle();
-                    
-                    //Load in any text to transmit
-                    TextQueue_LoadTransmitBuffer();
-                    
-                    //Run the CDC Class Interface
-                    if (USB_CDCVirtualSerialPortHandler() != SUCCESS)
-                    {
-                        usbState = USB_ERROR;
-                    }
-                    
-                    //Handle USB Traffic
-                    if (USBDevice_Handle() != SUCCESS)
-                    {
-                        usbState = USB_ERROR;
-                    }
-                }
-                break;
-            }
-            case USB_ERROR:
-            {
-                //USB Error
-                NANO_LED0_SetLow();
-                
-                if (!AC0_Read())
-                {
-                    //VBUS is disconnected
-                    usbState = USB_DISCONNECTED;
-                }
-                break;
-            }
-            default:
-            {
-                break;
-            }
-        }
+        //Run the next task, or sleep until an interrupt
+        Scheduler_Handle();
     }    
 }
\ No newline at end of file
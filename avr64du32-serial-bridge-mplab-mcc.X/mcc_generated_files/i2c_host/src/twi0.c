@@ -32,6 +32,7 @@
 */
 
 #include "../twi0.h"
+#include "../twi0_trace.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include "../../system/utils/compiler.h"
@@ -287,11 +288,13 @@ void TWI0_Tasks(void)
 static void TWI0_ReadStart(void)
 {
     twi0_Status.state = I2C_EVENT_SEND_RD_ADDR();
+    TWI0_TRACE(TWI0_TRACE_STATE, twi0_Status.state);
 }
 
 static void TWI0_WriteStart(void)
 {
     twi0_Status.state = I2C_EVENT_SEND_WR_ADDR();
+    TWI0_TRACE(TWI0_TRACE_STATE, twi0_Status.state);
 }
 
 static void TWI0_Close(void)
@@ -309,6 +312,7 @@ static void TWI0_Close(void)
 static void TWI0_EventHandler(void)
 {
     twi0_Status.state = twi0_eventTable[twi0_Status.state]();
+    TWI0_TRACE(TWI0_TRACE_STATE, twi0_Status.state);
 }
 
 static void TWI0_ErrorEventHandler(void)
@@ -338,6 +342,7 @@ static void TWI0_ErrorEventHandler(void)
         TWI0.MSTATUS |= TWI_ARBLOST_bm;
     }
     twi0_Status.state = twi0_eventTable[twi0_Status.state]();
+    TWI0_TRACE(TWI0_TRACE_STATE, twi0_Status.state);
     if(twi0_Status.errorState != I2C_ERROR_NONE)
     {
         TWI0_Callback();
@@ -0,0 +1,52 @@
+/**
+ * TWI0 Trace Hooks Header File
+ * @file twi0_trace.h
+ * @ingroup i2c_host
+ * @brief This file contains the hooks that report I2C host state changes to an application trace
+ */
+
+#ifndef TWI0_TRACE_H
+#define TWI0_TRACE_H
+
+#include <stdint.h>
+
+/**
+ * @ingroup i2c_host
+ * @def TWI0_TRACE_ENABLE
+ * @brief Reports the host state machine through TWI0_TraceEvent(). Set to 0U to leave the hooks out.
+ */
+#ifndef TWI0_TRACE_ENABLE
+#define TWI0_TRACE_ENABLE 1U
+#endif
+
+/**
+ * @ingroup i2c_host
+ * @enum TWI0_TRACE_EVENT_t
+ * @brief Events reported through TWI0_TRACE(), the payload is in the comment.
+ */
+typedef enum
+{
+    TWI0_TRACE_STATE = 0 /**<Host state after a start or an interrupt, according to i2c_event_states_t*/
+} TWI0_TRACE_EVENT_t;
+
+#if TWI0_TRACE_ENABLE
+/**
+ * @ingroup i2c_host
+ * @brief Records a host event, called from the TWI0 interrupt and the main loop. Implemented by the application.
+ * @param event - Event according to TWI0_TRACE_EVENT_t
+ * @param payload - Event payload
+ * @return None.
+ */
+void TWI0_TraceEvent(TWI0_TRACE_EVENT_t event, uint8_t payload);
+
+/**
+ * @ingroup i2c_host
+ * @def TWI0_TRACE
+ * @brief Reports an event with its payload to TWI0_TraceEvent().
+ */
+#define TWI0_TRACE(event, payload) TWI0_TraceEvent((event), (uint8_t)(payload))
+#else
+#define TWI0_TRACE(event, payload)
+#endif
+
+#endif /* TWI0_TRACE_H */
@@ -32,6 +32,30 @@
 
 #include "../spi0.h"
 #include "../spi_polling_types.h"
+#include "../../system/clock.h"
+
+/**
+ * @ingroup spi0
+ * @def SPI0_BOARD_SCK_MAX
+ * @brief Fastest SCK of the board configuration, the prescaler is the smallest that stays at or below it at F_CPU.
+ */
+#define SPI0_BOARD_SCK_MAX 1500000UL
+
+#if ((F_CPU / 2UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_CLK2X_bm | SPI_PRESC_DIV4_gc)
+#elif ((F_CPU / 4UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_PRESC_DIV4_gc)
+#elif ((F_CPU / 8UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_CLK2X_bm | SPI_PRESC_DIV16_gc)
+#elif ((F_CPU / 16UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_PRESC_DIV16_gc)
+#elif ((F_CPU / 32UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_CLK2X_bm | SPI_PRESC_DIV64_gc)
+#elif ((F_CPU / 64UL) <= SPI0_BOARD_SCK_MAX)
+#define SPI0_BOARD_PRESC (SPI_PRESC_DIV64_gc)
+#else
+#define SPI0_BOARD_PRESC (SPI_PRESC_DIV128_gc)
+#endif
 
 const struct SPI_INTERFACE SPI0_Host = 
 {
@@ -53,7 +77,7 @@ const struct SPI_INTERFACE SPI0_Host =
 
 static const spi_configuration_t spi0_configuration[] =
 {
-    { 0x23, 0xc4 },
+    { (SPI_MASTER_bm | SPI0_BOARD_PRESC | SPI_ENABLE_bm), 0xc4 },
     { 0x35, 0xC4 }
 };
 
@@ -35,7 +35,7 @@
 #define CLOCK_H
 
 #ifndef F_CPU
-#define F_CPU 20000000UL
+#define F_CPU 24000000UL
 #endif
 
 #include "ccp.h"
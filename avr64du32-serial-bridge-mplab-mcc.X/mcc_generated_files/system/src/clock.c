@@ -49,8 +49,15 @@ void CLOCK_Initialize(void)
     //RUNSTDBY disabled; 
     ccp_write_io((void*)&(CLKCTRL.OSC32KCTRLA),0x0);
 
-    //AUTOTUNE OFF; FRQSEL 20 MHz system clock; RUNSTDBY disabled; ALGSEL BIN; 
-    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA),0x20);
+#if (F_CPU == 24000000UL)
+    //AUTOTUNE SOF; FRQSEL 24 MHz system clock; RUNSTDBY disabled; ALGSEL BIN; 
+    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA),0x26);
+#elif (F_CPU == 20000000UL)
+    //AUTOTUNE SOF; FRQSEL 20 MHz system clock; RUNSTDBY disabled; ALGSEL BIN; 
+    ccp_write_io((void*)&(CLKCTRL.OSCHFCTRLA),0x22);
+#else
+#error "F_CPU must be 20 MHz or 24 MHz"
+#endif
 
     //TUNE 0x0; 
     ccp_write_io((void*)&(CLKCTRL.OSCHFTUNE),0x0);
@@ -76,8 +83,8 @@ void CLOCK_Initialize(void)
     //
     ccp_write_io((void*)&(CLKCTRL.USBPLLSTATUS),0x0);
 
-    //TIMEBASE 20; 
-    ccp_write_io((void*)&(CLKCTRL.MCLKTIMEBASE),0x14);
+    //TIMEBASE F_CPU in MHz; 
+    ccp_write_io((void*)&(CLKCTRL.MCLKTIMEBASE),(uint8_t)((F_CPU + 999999UL) / 1000000UL));
 
 
     // System clock stability check by polling the status register.
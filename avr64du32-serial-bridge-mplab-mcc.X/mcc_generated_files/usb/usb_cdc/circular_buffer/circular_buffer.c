@@ -30,6 +30,7 @@
  */
 
 #include "circular_buffer.h"
+#include <usb_trace.h>
 
 BUFFER_RETURN_CODE_t CIRCBUF_Enqueue(CIRCULAR_BUFFER_t *buffer, uint8_t data)
 {
@@ -55,6 +56,12 @@ BUFFER_RETURN_CODE_t CIRCBUF_Enqueue(CIRCULAR_BUFFER_t *buffer, uint8_t data)
         buffer->content[buffer->head] = data;
         // Updates head
         buffer->head = nextHead;
+
+        // Traces the transition to full
+        if (CIRCBUF_Full(buffer) == true)
+        {
+            USB_TRACE(USB_TRACE_CIRCBUF_FULL, (uintptr_t)buffer);
+        }
     }
 
     return status;
@@ -86,6 +93,12 @@ BUFFER_RETURN_CODE_t CIRCBUF_Dequeue(CIRCULAR_BUFFER_t *buffer, uint8_t *data)
         *data = buffer->content[buffer->tail];
         // Updates tail
         buffer->tail = nextTail;
+
+        // Traces the transition to empty
+        if (buffer->head == nextTail)
+        {
+            USB_TRACE(USB_TRACE_CIRCBUF_EMPTY, (uintptr_t)buffer);
+        }
     }
 
     return status;
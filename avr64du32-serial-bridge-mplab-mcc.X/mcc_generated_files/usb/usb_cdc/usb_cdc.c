@@ -44,6 +44,14 @@
 // Line state and setup
 STATIC uint16_t usbCDCControlLineState;
 STATIC USB_CDC_LINE_CODING_t usbCDCLineCoding;
+STATIC USB_SETUP_ENDOFREQUEST_CALLBACK_t usbCDCLineCodingCallback = NULL;
+
+#if USB_CDC_DATA_PORT_ENABLE
+// Line state and setup of the data port
+STATIC uint16_t usbCDCDataPortControlLineState;
+STATIC USB_CDC_LINE_CODING_t usbCDCDataPortLineCoding;
+STATIC USB_SETUP_ENDOFREQUEST_CALLBACK_t usbCDCDataPortLineCodingCallback = NULL;
+#endif
 
 void USB_CDCInitialize(void)
 {
@@ -55,6 +63,10 @@ void USB_CDCInitialize(void)
         .bParityType = USB_CDC_LINE_CODING_PARITY_NONE,
         .bDataBits = USB_CDC_LINE_CODING_8_DATA_BITS,
     };
+#if USB_CDC_DATA_PORT_ENABLE
+    usbCDCDataPortControlLineState = 0;
+    usbCDCDataPortLineCoding = usbCDCLineCoding;
+#endif
 
     USB_ClassRequestCallbackRegister(USB_CDCRequestHandler);
 }
@@ -62,6 +74,23 @@ void USB_CDCInitialize(void)
 RETURN_CODE_t USB_CDCRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
 {
     RETURN_CODE_t status = UNINITIALIZED;
+    uint16_t *controlLineStatePtr = &usbCDCControlLineState;
+    USB_CDC_LINE_CODING_t *lineCodingPtr = &usbCDCLineCoding;
+    USB_SETUP_ENDOFREQUEST_CALLBACK_t lineCodingCallback = usbCDCLineCodingCallback;
+
+#if USB_CDC_DATA_PORT_ENABLE
+    // Each CDC function has its own line state and coding, selected by the communication interface in wIndex
+    if (USB_CDC_DATA_PORT_COMM_INTERFACE == setupRequestPtr->wIndex)
+    {
+        controlLineStatePtr = &usbCDCDataPortControlLineState;
+        lineCodingPtr = &usbCDCDataPortLineCoding;
+        lineCodingCallback = usbCDCDataPortLineCodingCallback;
+    }
+    else
+    {
+        ; // Command port
+    }
+#endif
 
     // Tests if recipient is interface
     if (USB_REQUEST_RECIPIENT_INTERFACE == (USB_REQUEST_RECIPIENT_t)setupRequestPtr->bmRequestType.recipient)
@@ -76,7 +105,7 @@ RETURN_CODE_t USB_CDCRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
                 switch (setupRequestPtr->bRequest)
                 {
                 case USB_CDC_REQUEST_GET_LINE_CODING:
-                    status = USB_TransferControlDataSet((uint8_t *)&usbCDCLineCoding, sizeof(USB_CDC_LINE_CODING_t), NULL);
+                    status = USB_TransferControlDataSet((uint8_t *)lineCodingPtr, sizeof(USB_CDC_LINE_CODING_t), NULL);
                     break;
                 default:
                     status = UNSUPPORTED; // Currently unsupported request
@@ -97,10 +126,11 @@ RETURN_CODE_t USB_CDCRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
                 switch (setupRequestPtr->bRequest)
                 {
                 case USB_CDC_REQUEST_SET_LINE_CODING:
-                    status = USB_TransferControlDataSet((uint8_t *)&usbCDCLineCoding, sizeof(USB_CDC_LINE_CODING_t), NULL);
+                    // Application is notified once the data stage has completed
+                    status = USB_TransferControlDataSet((uint8_t *)lineCodingPtr, sizeof(USB_CDC_LINE_CODING_t), lineCodingCallback);
                     break;
                 case USB_CDC_REQUEST_SET_CONTROL_LINE_STATE:
-                    usbCDCControlLineState = setupRequestPtr->wValue;
+                    *controlLineStatePtr = setupRequestPtr->wValue;
                     status = SUCCESS;
                     break;
                 default:
@@ -127,7 +157,17 @@ bool USB_CDCDataTerminalReady(void)
     return usbCDCControlLineState & USB_CDC_DATA_TERMINAL_READY_bm;
 }
 
-void USB_CDCSetBaud(uint16_t baud)
+bool USB_CDCRequestToSend(void)
+{
+    return usbCDCControlLineState & USB_CDC_REQUEST_TO_SEND_bm;
+}
+
+void USB_CDCLineCodingCallbackRegister(USB_SETUP_ENDOFREQUEST_CALLBACK_t callback)
+{
+    usbCDCLineCodingCallback = callback;
+}
+
+void USB_CDCSetBaud(uint32_t baud)
 {
     usbCDCLineCoding.dwDTERate = baud;
 }
@@ -165,4 +205,41 @@ void USB_CDCSetDataBits(USD_CDC_LINE_CODING_DATA_BITS_t numDataBits)
 USD_CDC_LINE_CODING_DATA_BITS_t USB_CDCGetDataBits(void)
 {
     return usbCDCLineCoding.bDataBits;
-}
\ No newline at end of file
+}
+
+#if USB_CDC_DATA_PORT_ENABLE
+bool USB_CDCDataPortDataTerminalReady(void)
+{
+    return usbCDCDataPortControlLineState & USB_CDC_DATA_TERMINAL_READY_bm;
+}
+
+bool USB_CDCDataPortRequestToSend(void)
+{
+    return usbCDCDataPortControlLineState & USB_CDC_REQUEST_TO_SEND_bm;
+}
+
+void USB_CDCDataPortLineCodingCallbackRegister(USB_SETUP_ENDOFREQUEST_CALLBACK_t callback)
+{
+    usbCDCDataPortLineCodingCallback = callback;
+}
+
+uint32_t USB_CDCDataPortGetBaud(void)
+{
+    return usbCDCDataPortLineCoding.dwDTERate;
+}
+
+USB_CDC_LINE_CODING_STOP_BITS_t USB_CDCDataPortGetStopBits(void)
+{
+    return usbCDCDataPortLineCoding.bCharFormat;
+}
+
+USD_CDC_LINE_CODING_PARITY_t USB_CDCDataPortGetParity(void)
+{
+    return usbCDCDataPortLineCoding.bParityType;
+}
+
+USD_CDC_LINE_CODING_DATA_BITS_t USB_CDCDataPortGetDataBits(void)
+{
+    return usbCDCDataPortLineCoding.bDataBits;
+}
+#endif
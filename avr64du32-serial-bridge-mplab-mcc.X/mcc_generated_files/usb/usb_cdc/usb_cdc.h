@@ -35,6 +35,7 @@
 #include <usb_common_elements.h>
 #include <usb_protocol_cdc.h>
 #include <usb_protocol_headers.h>
+#include <usb_config.h>
 
 /**
  * @ingroup usb_cdc
@@ -61,13 +62,30 @@ RETURN_CODE_t USB_CDCRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr);
  */
 bool USB_CDCDataTerminalReady(void);
 
+/**
+ * @ingroup usb_cdc
+ * @brief Checks if the Request To Send bit has been set from the host.
+ * @param None.
+ * @retval 0 - False if bit not set
+ * @retval 1 - True if bit set
+ */
+bool USB_CDCRequestToSend(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Registers a callback for when the host has changed the line coding with SET_LINE_CODING.
+ * @param callback - Function called once the new line coding has been received, or NULL
+ * @return None.
+ */
+void USB_CDCLineCodingCallbackRegister(USB_SETUP_ENDOFREQUEST_CALLBACK_t callback);
+
 /**
  * @ingroup usb_cdc
  * @brief Sets the data transfer baud rate for the CDC communication.
  * @param baud - Data transfer baud rate
  * @return None.
  */
-void USB_CDCSetBaud(uint16_t baud);
+void USB_CDCSetBaud(uint32_t baud);
 
 /**
  * @ingroup usb_cdc
@@ -125,4 +143,64 @@ void USB_CDCSetDataBits(USD_CDC_LINE_CODING_DATA_BITS_t numDataBits);
  */
 USD_CDC_LINE_CODING_DATA_BITS_t USB_CDCGetDataBits(void);
 
+#if USB_CDC_DATA_PORT_ENABLE
+/**
+ * @ingroup usb_cdc
+ * @brief Checks if the Data Terminal Equipment bit of the data port has been set from the host.
+ * @param None.
+ * @retval 0 - False if bit not set
+ * @retval 1 - True if bit set
+ */
+bool USB_CDCDataPortDataTerminalReady(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Checks if the Request To Send bit of the data port has been set from the host.
+ * @param None.
+ * @retval 0 - False if bit not set
+ * @retval 1 - True if bit set
+ */
+bool USB_CDCDataPortRequestToSend(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Registers a callback for when the host has changed the line coding of the data port with SET_LINE_CODING.
+ * @param callback - Function called once the new line coding has been received, or NULL
+ * @return None.
+ */
+void USB_CDCDataPortLineCodingCallbackRegister(USB_SETUP_ENDOFREQUEST_CALLBACK_t callback);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Gets the data transfer baud rate set by the host for the data port.
+ * @param None.
+ * @return baud - Data transfer baud rate
+ */
+uint32_t USB_CDCDataPortGetBaud(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Gets the number of stop bits set by the host for the data port.
+ * @param None.
+ * @return numStopBits - Number of stop bits
+ */
+USB_CDC_LINE_CODING_STOP_BITS_t USB_CDCDataPortGetStopBits(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Gets the parity set by the host for the data port.
+ * @param None.
+ * @return parity - Data transfer parity
+ */
+USD_CDC_LINE_CODING_PARITY_t USB_CDCDataPortGetParity(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Gets the number of data bits set by the host for the data port.
+ * @param None.
+ * @return numDataBits - Number of data bits
+ */
+USD_CDC_LINE_CODING_DATA_BITS_t USB_CDCDataPortGetDataBits(void);
+#endif
+
 #endif /* USB_CDC_H */
\ No newline at end of file
@@ -40,6 +40,12 @@
 // ZLP state
 static bool zlpStateTX = true;
 
+// Echo of received data
+STATIC bool usbCDCEchoEnabled = true;
+
+// Received bytes dropped because the receive buffer was full
+STATIC uint32_t usbCDCReceiveDropped = 0;
+
 // USB Pipes
 STATIC USB_PIPE_t CDCTxPipe = {
     .address = USB_CDC_BULK_EP_IN,
@@ -51,6 +57,25 @@ STATIC USB_PIPE_t CDCRxPipe = {
     .direction = USB_EP_DIR_OUT,
 };
 
+STATIC USB_PIPE_t CDCNotificationPipe = {
+    .address = USB_CDC_INTERRUPT_EP,
+    .direction = USB_EP_DIR_IN,
+};
+
+// SERIAL_STATE notification
+STATIC USB_CDC_SERIAL_STATE_NOTIFICATION_t usbCDCSerialStateNotification __attribute__((aligned(2))) = {
+    .header = {
+        .bmRequestType = USB_CDC_NOTIFICATION_REQUEST_TYPE,
+        .bNotification = USB_CDC_NOTIFICATION_SERIAL_STATE,
+        .wValue = 0,
+        .wIndex = USB_CDC_COMM_INTERFACE,
+        .wLength = sizeof(uint16_t),
+    },
+    .bmUartState = 0,
+};
+STATIC volatile uint16_t usbCDCSerialState;
+STATIC volatile bool usbCDCSerialStatePending;
+
 // RX Buffer
 STATIC uint8_t usbCDCReceiveTempBuffer[USB_CDC_RX_PACKET_SIZE] __attribute__((aligned(2)));
 STATIC uint8_t usbCDCReceiveArray[USB_CDC_RX_BUFFER_SIZE];
@@ -60,7 +85,8 @@ STATIC CIRCULAR_BUFFER_t usbCDCReceiveBuffer = {
     .tail = 0,
     .maxLength = USB_CDC_RX_BUFFER_SIZE,
 };
-// TX Buffer
+// TX Buffer, data is staged out of the circular buffer so it can be refilled during a transfer
+STATIC uint8_t usbCDCTransmitStage[USB_CDC_TX_BUFFER_SIZE] __attribute__((aligned(2)));
 STATIC uint8_t usbCDCTransmitArray[USB_CDC_TX_BUFFER_SIZE];
 STATIC CIRCULAR_BUFFER_t usbCDCTransmitBuffer = {
     .content = usbCDCTransmitArray,
@@ -71,12 +97,16 @@ STATIC CIRCULAR_BUFFER_t usbCDCTransmitBuffer = {
 
 void USB_CDCVirtualSerialPortInitialize(void)
 {
+    usbCDCSerialState = 0;
+    usbCDCSerialStatePending = false;
+
     USB_CDCInitialize();
 }
 
-RETURN_CODE_t USB_CDCVirtualSerialPortHandler(void)
+STATIC RETURN_CODE_t USB_CDCTransmitHandler(void)
 {
     RETURN_CODE_t status = SUCCESS;
+    uint16_t length = 0;
 
     // Checks if data have been added to transmit buffer
     if (false == CIRCBUF_Empty(&usbCDCTransmitBuffer))
@@ -84,7 +114,13 @@ RETURN_CODE_t USB_CDCVirtualSerialPortHandler(void)
         // Transmits data to host if pipe not busy
         if (false == USB_PipeStatusIsBusy(CDCTxPipe))
         {
-            status = USB_TransferWriteStart(CDCTxPipe, usbCDCTransmitArray, usbCDCTransmitBuffer.head, zlpStateTX, USB_CDCDataTransmitted);
+            // Moves the data to the stage, the circular buffer is free for new data during the transfer
+            while ((length < USB_CDC_TX_BUFFER_SIZE) && (BUFFER_SUCCESS == CIRCBUF_Dequeue(&usbCDCTransmitBuffer, &usbCDCTransmitStage[length])))
+            {
+                length++;
+            }
+
+            status = USB_TransferWriteStart(CDCTxPipe, usbCDCTransmitStage, length, zlpStateTX, USB_CDCDataTransmitted);
         }
         else
         {
@@ -96,30 +132,80 @@ RETURN_CODE_t USB_CDCVirtualSerialPortHandler(void)
         // No data to transmit
     }
 
-    // Checks if outgoing data transmitted or not available
-    if (SUCCESS == status)
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_CDCNotificationHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if the UART state changed since the last notification
+    if (true == usbCDCSerialStatePending)
     {
-        // Checks if room exist for 1 USB CDC packet in the receive buffer
-        if (USB_CDC_RX_PACKET_SIZE <= CIRCBUF_FreeSpace(&usbCDCReceiveBuffer))
+        // Sends the notification if the previous one has been read by the host
+        if (false == USB_PipeStatusIsBusy(CDCNotificationPipe))
         {
-            // Receives data from host if pipe not busy
-            if (false == USB_PipeStatusIsBusy(CDCRxPipe))
-            {
-                status = USB_TransferReadStart(CDCRxPipe, usbCDCReceiveTempBuffer, USB_CDC_RX_PACKET_SIZE, false, USB_CDCDataReceived);
-            }
-            else
-            {
-                // Pipe is busy, retry on next iteration
-            }
+            usbCDCSerialStatePending = false;
+            usbCDCSerialStateNotification.bmUartState = usbCDCSerialState;
+
+            status = USB_TransferWriteStart(CDCNotificationPipe, (uint8_t *)&usbCDCSerialStateNotification, sizeof(USB_CDC_SERIAL_STATE_NOTIFICATION_t), false, USB_CDCNotificationTransmitted);
         }
         else
         {
-            // RX buffer is full, retry on next iteration
+            // Pipe is busy, retry on next iteration
         }
     }
     else
     {
-        ; // Skips read if write failed
+        // No notification to send
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_CDCReceiveHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if room exist for 1 USB CDC packet in the receive buffer
+    if (USB_CDC_RX_PACKET_SIZE <= CIRCBUF_FreeSpace(&usbCDCReceiveBuffer))
+    {
+        // Receives data from host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(CDCRxPipe))
+        {
+            status = USB_TransferReadStart(CDCRxPipe, usbCDCReceiveTempBuffer, USB_CDC_RX_PACKET_SIZE, false, USB_CDCDataReceived);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // RX buffer is full, retry on next iteration
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_CDCVirtualSerialPortHandler(void)
+{
+    RETURN_CODE_t status;
+    RETURN_CODE_t stepStatus;
+
+    // Each direction runs on its own, an error on one does not stall the others
+    status = USB_CDCTransmitHandler();
+
+    stepStatus = USB_CDCNotificationHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+
+    stepStatus = USB_CDCReceiveHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
     }
 
     return status;
@@ -135,23 +221,147 @@ CDC_RETURN_CODE_t USB_CDCWrite(uint8_t data)
     return CIRCBUF_Enqueue(&usbCDCTransmitBuffer, data);
 }
 
+uint16_t USB_CDCReadBlock(uint8_t *data, uint16_t maxLength)
+{
+    uint16_t count = 0;
+
+    while ((count < maxLength) && (BUFFER_SUCCESS == CIRCBUF_Dequeue(&usbCDCReceiveBuffer, &data[count])))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+uint16_t USB_CDCWriteBlock(const uint8_t *data, uint16_t length)
+{
+    uint16_t count = 0;
+
+    while ((count < length) && (BUFFER_SUCCESS == CIRCBUF_Enqueue(&usbCDCTransmitBuffer, data[count])))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+void USB_CDCEchoEnable(bool enable)
+{
+    usbCDCEchoEnabled = enable;
+}
+
+uint32_t USB_CDCReceiveDroppedGet(void)
+{
+    return usbCDCReceiveDropped;
+}
+
 bool USB_CDCTxBusy(void)
 {
     return CIRCBUF_Full(&usbCDCTransmitBuffer) || USB_PipeStatusIsBusy(CDCTxPipe);
 }
 
+RETURN_CODE_t USB_CDCTransmitFlush(void)
+{
+    // Stale data may be waiting in the endpoint for a host that stopped reading
+    RETURN_CODE_t status = USB_TransferAbort(CDCTxPipe);
+
+    if (SUCCESS == status)
+    {
+        usbCDCTransmitBuffer.head = 0;
+        usbCDCTransmitBuffer.tail = 0;
+    }
+    else
+    {
+        ; // Abort failed, keep the buffer until the transfer ends
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_CDCPipesReset(void)
+{
+    // Buffered data is kept, the handler restarts the transfers on the next call
+    RETURN_CODE_t status = USB_TransferAbort(CDCTxPipe);
+    RETURN_CODE_t pipeStatus;
+
+    pipeStatus = USB_TransferAbort(CDCRxPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+    pipeStatus = USB_TransferAbort(CDCNotificationPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+    return status;
+}
+
+void USB_CDCSerialStateSet(uint16_t state)
+{
+    uint16_t newState = (usbCDCSerialState & ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm) | (state & USB_CDC_SERIAL_STATE_CONTINUOUS_gm);
+
+    if (newState != usbCDCSerialState)
+    {
+        usbCDCSerialState = newState;
+        usbCDCSerialStatePending = true;
+    }
+}
+
+void USB_CDCSerialStateEvent(uint16_t events)
+{
+    events &= ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm;
+
+    if (0U != events)
+    {
+        usbCDCSerialState |= events;
+        usbCDCSerialStatePending = true;
+    }
+}
+
+void USB_CDCNotificationTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+    (void)(bytesTransferred);
+
+    if (USB_PIPE_TRANSFER_OK != status)
+    {
+        // Notification lost, send the current state again, events included
+        usbCDCSerialStatePending = true;
+    }
+    else
+    {
+        // Events are only reported once, events raised since the notification was started are kept
+        usbCDCSerialState &= ~(usbCDCSerialStateNotification.bmUartState & ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm);
+    }
+}
+
 void USB_CDCDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
 {
     (void)(pipe);
 
     if (USB_PIPE_TRANSFER_OK == status)
     {
-        // Echo data back
-        USB_TransferWriteStart(CDCTxPipe, usbCDCReceiveTempBuffer, bytesTransferred, zlpStateTX, NULL);
         // Moves received data to circular buffer
         for (uint16_t i = 0; i < bytesTransferred; i++)
         {
-            CIRCBUF_Enqueue(&usbCDCReceiveBuffer, usbCDCReceiveTempBuffer[i]);
+            if (BUFFER_SUCCESS != CIRCBUF_Enqueue(&usbCDCReceiveBuffer, usbCDCReceiveTempBuffer[i]))
+            {
+                // Receive buffer full, the byte is dropped
+                usbCDCReceiveDropped++;
+            }
+
+            if (true == usbCDCEchoEnabled)
+            {
+                // Echo data back through the transmit buffer, so it can't collide with an ongoing transfer
+                CIRCBUF_Enqueue(&usbCDCTransmitBuffer, usbCDCReceiveTempBuffer[i]);
+            }
+            else
+            {
+                ; // Data is only buffered
+            }
         }
     }
     else
@@ -163,16 +373,8 @@ void USB_CDCDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t
 void USB_CDCDataTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
 {
     (void)(pipe);
+    (void)(status);
     (void)(bytesTransferred);
 
-    if (USB_PIPE_TRANSFER_OK == status)
-    {
-        // Data transmitted, reset transmit buffer
-        usbCDCTransmitBuffer.head = 0;
-        usbCDCTransmitBuffer.tail = 0;
-    }
-    else
-    {
-        ; // Transfer error, do nothing in callback
-    }
+    // The stage is free again, data added during the transfer is sent on the next call of the handler
 }
\ No newline at end of file
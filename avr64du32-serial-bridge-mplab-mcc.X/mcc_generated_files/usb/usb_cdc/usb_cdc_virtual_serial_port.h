@@ -83,6 +83,40 @@ CDC_RETURN_CODE_t USB_CDCRead(uint8_t *data);
  */
 CDC_RETURN_CODE_t USB_CDCWrite(uint8_t data);
 
+/**
+ * @ingroup usb_cdc
+ * @brief Pulls up to maxLength bytes from the CDC receive buffer.
+ * @param data - Pointer to application receive buffer
+ * @param maxLength - Size of the application receive buffer
+ * @return Number of bytes copied to data
+ */
+uint16_t USB_CDCReadBlock(uint8_t *data, uint16_t maxLength);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Adds as much of a block of data as fits to the CDC transmit buffer.
+ * @param data - Pointer to data to be transmitted
+ * @param length - Length in number of bytes for data to be transmitted
+ * @return Number of bytes added to the transmit buffer
+ */
+uint16_t USB_CDCWriteBlock(const uint8_t *data, uint16_t length);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Enables or disables the echo of received data back to the host.
+ * @param enable - true to echo received data, false to only buffer it
+ * @return None.
+ */
+void USB_CDCEchoEnable(bool enable);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Returns the number of received bytes dropped because the receive buffer was full.
+ * @param None.
+ * @return Dropped bytes since startup, wraps around after 2^32
+ */
+uint32_t USB_CDCReceiveDroppedGet(void);
+
 /**
  * @ingroup usb_cdc
  * @brief Checks if the transmit buffer is full.
@@ -92,6 +126,50 @@ CDC_RETURN_CODE_t USB_CDCWrite(uint8_t data);
  */
 bool USB_CDCTxBusy(void);
 
+/**
+ * @ingroup usb_cdc
+ * @brief Aborts the ongoing IN transfer and empties the CDC transmit buffer.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_CDCTransmitFlush(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Aborts the transfers on the CDC data and notification pipes, buffered data is kept.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_CDCPipesReset(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Sets the continuous part of the UART state (DCD and DSR) reported by SERIAL_STATE notifications.
+ *        A notification is sent on the interrupt endpoint if the state changed.
+ * @param state - Bitmap of USB_CDC_SERIAL_STATE_RX_CARRIER_bm and USB_CDC_SERIAL_STATE_TX_CARRIER_bm
+ * @return None.
+ */
+void USB_CDCSerialStateSet(uint16_t state);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Reports UART state events (overrun, ring signal, break, framing or parity error) with a SERIAL_STATE notification.
+ *        Events are cleared once the host has read the notification, a failed notification is sent again.
+ * @param events - Bitmap of USB_CDC_SERIAL_STATE_t event bits
+ * @return None.
+ */
+void USB_CDCSerialStateEvent(uint16_t events);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Callback function called after the SERIAL_STATE notification is sent.
+ * @param pipe - USB pipe used for the started transaction
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes transmitted in the transaction
+ * @return None.
+ */
+void USB_CDCNotificationTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
 /**
  * @ingroup usb_cdc
  * @brief Callback function called after the USB IN transaction started.
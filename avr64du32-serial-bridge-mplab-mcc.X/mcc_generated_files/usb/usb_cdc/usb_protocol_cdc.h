@@ -408,4 +408,64 @@ typedef enum USD_CDC_CONTROL_LINE_STATE_enum
 
 } USD_CDC_CONTROL_LINE_STATE_t;
 
+// Notification:
+
+/**
+ * @ingroup usb_cdc
+ * @struct USB_CDC_NOTIFICATION_HEADER_t
+ * @brief Type define for the header of a CDC notification sent on the interrupt endpoint.
+ */
+typedef struct USB_CDC_NOTIFICATION_HEADER_struct
+{
+    uint8_t bmRequestType; /**<Characteristics of the notification, 0xA1 for class notifications to the host*/
+    uint8_t bNotification; /**<Notification code*/
+    uint16_t wValue;       /**<Notification specific value*/
+    uint16_t wIndex;       /**<Interface the notification refers to*/
+    uint16_t wLength;      /**<Number of data bytes following the header*/
+
+} USB_CDC_NOTIFICATION_HEADER_t;
+
+/**
+ * @ingroup usb_cdc
+ * @struct USB_CDC_SERIAL_STATE_NOTIFICATION_t
+ * @brief Type define for the CDC SERIAL_STATE notification.
+ */
+typedef struct USB_CDC_SERIAL_STATE_NOTIFICATION_struct
+{
+    USB_CDC_NOTIFICATION_HEADER_t header; /**<Notification header*/
+    uint16_t bmUartState;                 /**<UART state bitmap, see USB_CDC_SERIAL_STATE_t*/
+
+} USB_CDC_SERIAL_STATE_NOTIFICATION_t;
+
+/**
+ * @ingroup usb_cdc
+ * @def USB_CDC_NOTIFICATION_REQUEST_TYPE
+ * @brief bmRequestType of a class notification sent from the interface to the host.
+ */
+#define USB_CDC_NOTIFICATION_REQUEST_TYPE 0xA1U
+
+/**
+ * @ingroup usb_cdc
+ * @enum USB_CDC_SERIAL_STATE_t
+ * @brief Type define for the UART state bitmap of the SERIAL_STATE notification.
+ */
+typedef enum USB_CDC_SERIAL_STATE_enum
+{
+    USB_CDC_SERIAL_STATE_RX_CARRIER_bm = 0x0001, /**<State of receiver carrier detection mechanism. This signal corresponds to V.24 signal 109 and RS-232 signal DCD.*/
+    USB_CDC_SERIAL_STATE_TX_CARRIER_bm = 0x0002, /**<State of transmission carrier. This signal corresponds to V.24 signal 106 and RS-232 signal DSR.*/
+    USB_CDC_SERIAL_STATE_BREAK_bm = 0x0004,      /**<State of break detection mechanism of the device*/
+    USB_CDC_SERIAL_STATE_RING_SIGNAL_bm = 0x0008, /**<State of ring signal detection of the device*/
+    USB_CDC_SERIAL_STATE_FRAMING_bm = 0x0010,    /**<A framing error has occurred*/
+    USB_CDC_SERIAL_STATE_PARITY_bm = 0x0020,     /**<A parity error has occurred*/
+    USB_CDC_SERIAL_STATE_OVERRUN_bm = 0x0040,    /**<Received data has been discarded due to overrun in the device*/
+
+} USB_CDC_SERIAL_STATE_t;
+
+/**
+ * @ingroup usb_cdc
+ * @def USB_CDC_SERIAL_STATE_CONTINUOUS_gm
+ * @brief Bits of the UART state that describe a continuous state. All other bits are events, reset after being sent.
+ */
+#define USB_CDC_SERIAL_STATE_CONTINUOUS_gm (USB_CDC_SERIAL_STATE_RX_CARRIER_bm | USB_CDC_SERIAL_STATE_TX_CARRIER_bm)
+
 #endif /* USB_PROTOCOL_CDC_H */
\ No newline at end of file
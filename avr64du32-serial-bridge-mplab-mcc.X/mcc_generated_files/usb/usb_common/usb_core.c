@@ -210,3 +210,48 @@ RETURN_CODE_t USB_Reset(void)
     }
     return status;
 }
+
+RETURN_CODE_t USB_BusReset(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Disables the interfaces of the active configuration.
+    if (USB_REQUEST_DEVICE_DISABLE_CONFIGURATION != USB_DescriptorActiveConfigurationValueGet())
+    {
+        status = USB_DescriptorConfigurationEnable(USB_REQUEST_DEVICE_DISABLE_CONFIGURATION);
+    }
+
+    // Clears the address and endpoint state, the peripheral stays enabled and attached.
+    SetupDeviceAddressReset();
+    USB_PeripheralBusReset();
+
+    // Reinitializes the endpoints.
+    USB_PIPE_t pipe = { .address = 0 };
+    while (pipe.address < USB_EP_NUM)
+    {
+        if (status == SUCCESS)
+        {
+            pipe.direction = USB_EP_DIR_OUT;
+            status = USB_PipeReset(pipe);
+        }
+        if (status == SUCCESS)
+        {
+            pipe.direction = USB_EP_DIR_IN;
+            status = USB_PipeReset(pipe);
+        }
+        pipe.address++;
+    }
+
+    // Initializes the control endpoints.
+    if (status == SUCCESS)
+    {
+        status = USB_ControlEndpointsInit();
+    }
+
+    if (status == SUCCESS)
+    {
+        status = USB_ControlTransferReset();
+    }
+
+    return status;
+}
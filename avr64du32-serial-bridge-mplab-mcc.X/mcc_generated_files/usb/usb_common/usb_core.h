@@ -92,4 +92,13 @@ RETURN_CODE_t USB_Stop(void);
  */
 RETURN_CODE_t USB_Reset(void);
 
+/**
+ * @ingroup usb_core
+ * @brief Returns the device to the default state after a bus reset while staying attached.
+ * Clears the configuration and address and reinitializes the endpoints and control transfer.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_BusReset(void);
+
 #endif /* USB_CORE_H */
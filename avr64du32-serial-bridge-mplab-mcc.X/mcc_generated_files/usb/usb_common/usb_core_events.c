@@ -43,6 +43,9 @@
 
 USB_EVENT_HANDLERS_t event;
 
+// Overflows and underflows on the endpoints other than the control endpoint
+STATIC uint32_t eventOverUnderflowCount = 0;
+
 RETURN_CODE_t USB_EventHandler(void)
 {
     RETURN_CODE_t status = SUCCESS;
@@ -77,7 +80,7 @@ RETURN_CODE_t USB_EventHandler(void)
             }
             pipe.address++;
         }
-        status = USB_Reset();
+        status = USB_BusReset();
     }
     uint8_t eventOverUnderflow = USB_EventOverUnderflowIsReceived();
     if (0u < eventOverUnderflow)
@@ -90,7 +93,8 @@ RETURN_CODE_t USB_EventHandler(void)
         }
         else
         {
-            // Non-control overunderflows currently ignored by event handler
+            // Non-control overunderflows are counted, the transfer itself is not affected
+            eventOverUnderflowCount++;
             status = SUCCESS;
         }
     }
@@ -168,3 +172,8 @@ void USB_ResumeCallbackRegister(USB_EVENT_CALLBACK_t callback)
 {
     event.ResumeCallback = callback;
 }
+
+uint32_t USB_EventOverUnderflowCountGet(void)
+{
+    return eventOverUnderflowCount;
+}
@@ -155,4 +155,12 @@ void USB_SuspendCallbackRegister(USB_EVENT_CALLBACK_t callback);
  */
 void USB_ResumeCallbackRegister(USB_EVENT_CALLBACK_t callback);
 
+/**
+ * @ingroup usb_core
+ * @brief Returns the number of overflows and underflows on the endpoints other than the control endpoint.
+ * @param None.
+ * @return Overflows and underflows since startup, wraps around after 2^32
+ */
+uint32_t USB_EventOverUnderflowCountGet(void);
+
 #endif /* USB_CORE_EVENTS_H */
@@ -96,6 +96,12 @@ void SetupDeviceAddressCallback(void)
     USB_ControlEndOfRequestCallbackRegister(NULL);
 }
 
+void SetupDeviceAddressReset(void)
+{
+    // The device returns to the default state, the host assigns a new address after a bus reset.
+    deviceAddress = 0u;
+}
+
 RETURN_CODE_t SetupDeviceRequestGetDescriptor(USB_SETUP_REQUEST_t *setupRequestPtr)
 {
     RETURN_CODE_t status = UNINITIALIZED;
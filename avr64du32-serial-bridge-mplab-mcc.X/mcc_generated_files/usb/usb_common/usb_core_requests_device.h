@@ -79,6 +79,14 @@ RETURN_CODE_t SetupDeviceRequestSetAddress(uint8_t address);
  */
 void SetupDeviceAddressCallback(void);
 
+/**
+ * @ingroup usb_core_requests
+ * @brief Clears the stored device address.
+ * @param None.
+ * @return None.
+ */
+void SetupDeviceAddressReset(void);
+
 /**
  * @ingroup usb_core_requests
  * @brief Gets the device descriptor.
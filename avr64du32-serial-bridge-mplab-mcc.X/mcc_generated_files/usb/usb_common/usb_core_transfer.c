@@ -39,6 +39,7 @@
 #include <usb_common_elements.h>
 #include <usb_config.h>
 #include <usb_peripheral.h>
+#include <usb_trace.h>
 
 RETURN_CODE_t USB_TransferWriteStart(USB_PIPE_t pipe, uint8_t *dataPtr, uint16_t dataSize, bool useZLP, USB_TRANSFER_END_CALLBACK_t callback)
 {
@@ -64,6 +65,7 @@ RETURN_CODE_t USB_TransferWriteStart(USB_PIPE_t pipe, uint8_t *dataPtr, uint16_t
         }
         USB_PipeTransferEndCallbackRegister(pipe, callback);
         status = USB_InTransactionRun(pipe);
+        USB_TRACE(USB_TRACE_TRANSFER_START, (pipe.direction << 7) | pipe.address);
     }
     return status;
 }
@@ -92,6 +94,7 @@ RETURN_CODE_t USB_TransferReadStart(USB_PIPE_t pipe, uint8_t *dataPtr, uint16_t
         }
         USB_PipeTransferEndCallbackRegister(pipe, callback);
         status = USB_OutTransactionRun(pipe);
+        USB_TRACE(USB_TRACE_TRANSFER_START, (pipe.direction << 7) | pipe.address);
     }
 
     return status;
@@ -103,6 +106,13 @@ RETURN_CODE_t USB_TransferControlDataSet(uint8_t *dataPtr, uint16_t dataSize, US
     return USB_ControlTransferDataSet(dataPtr, dataSize);
 }
 
+RETURN_CODE_t USB_TransferControlWriteSet(uint8_t *dataPtr, uint16_t dataSize, USB_SETUP_DATA_RECEIVED_CALLBACK_t callback)
+{
+    USB_ControlEndOfRequestCallbackRegister(NULL);
+    USB_ControlDataReceivedCallbackRegister(callback);
+    return USB_ControlTransferDataSet(dataPtr, dataSize);
+}
+
 RETURN_CODE_t USB_TransferAbort(USB_PIPE_t pipe)
 {
     RETURN_CODE_t status = UNINITIALIZED;
@@ -128,7 +138,7 @@ RETURN_CODE_t USB_TransferAbort(USB_PIPE_t pipe)
     return status;
 }
 
-RETURN_CODE_t USB_TransferHandler(void)
+STATIC RETURN_CODE_t USB_TransferHandleNext(void)
 {
     RETURN_CODE_t status = UNINITIALIZED;
 
@@ -162,6 +172,12 @@ RETURN_CODE_t USB_TransferHandler(void)
             {
                 // Regular handling of all regular endpoints.
                 status = USB_PipeTransactionComplete(pipe);
+
+                // The transfer has ended once the pipe is no longer busy.
+                if (USB_PipeStatusIsBusy(pipe) == false)
+                {
+                    USB_TRACE(USB_TRACE_TRANSFER_END, (pipe.direction << 7) | pipe.address);
+                }
             }
         }
     }
@@ -173,3 +189,18 @@ RETURN_CODE_t USB_TransferHandler(void)
 
     return status;
 }
+
+RETURN_CODE_t USB_TransferHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+    uint8_t budget = USB_TRANSFER_HANDLER_BUDGET;
+
+    // Drains the setup packet and the transaction complete FIFO, bounded by the budget.
+    while ((SUCCESS == status) && (0u < budget) && ((USB_SetupIsReceived() == true) || (USB_TransactionIsCompleted() == true)))
+    {
+        status = USB_TransferHandleNext();
+        budget--;
+    }
+
+    return status;
+}
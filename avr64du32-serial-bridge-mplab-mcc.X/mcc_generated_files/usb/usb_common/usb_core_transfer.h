@@ -89,6 +89,20 @@ RETURN_CODE_t USB_TransferReadStart(USB_PIPE_t pipe, uint8_t *dataPtr, uint16_t
  */
 RETURN_CODE_t USB_TransferControlDataSet(uint8_t *dataPtr, uint16_t dataSize, USB_SETUP_ENDOFREQUEST_CALLBACK_t callback);
 
+/**
+ * @ingroup usb_core_transfer
+ * @brief Sets up the data stage of a vendor or class control write that is checked before the status stage.
+ *
+ * The callback runs once all data has been received. If it returns an error, the status stage is stalled
+ * and the host sees the request fail, otherwise the request completes.
+ *
+ * @param *dataPtr - The pointer to the buffer for the data
+ * @param dataSize - The size of the data to receive
+ * @param callback - Pointer to a function to be called when the data stage is complete
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_TransferControlWriteSet(uint8_t *dataPtr, uint16_t dataSize, USB_SETUP_DATA_RECEIVED_CALLBACK_t callback);
+
 /**
  * @ingroup usb_core_transfer
  * @brief Aborts an ongoing transfer.
@@ -106,6 +120,7 @@ RETURN_CODE_t USB_TransferAbort(USB_PIPE_t pipe);
  *
  * Checks if a setup package is received or if a transaction is completed and which pipe has a completed transaction, then it handles them accordingly.
  * Sends an ACK upon completed transaction confirmation.
+ * Up to USB_TRANSFER_HANDLER_BUDGET setup packets and completed transactions are handled per call.
  *
  * @param None.
  * @return SUCCESS or an Error code according to RETURN_CODE_t
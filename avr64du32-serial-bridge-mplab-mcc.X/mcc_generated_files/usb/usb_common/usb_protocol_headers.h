@@ -648,6 +648,15 @@ typedef RETURN_CODE_t (*USB_SETUP_OVERUNDERRUN_CALLBACK_t)(void);
  */
 typedef void (*USB_SETUP_ENDOFREQUEST_CALLBACK_t)(void);
 
+/**
+ * @ingroup usb_protocol
+ * @brief Function callback type USB_SETUP_DATA_RECEIVED_CALLBACK_t.
+ * Callback type used when the data stage of a control write is complete, before the status stage.
+ * @param None.
+ * @return SUCCESS to complete the request, or an Error code to stall the status stage
+ */
+typedef RETURN_CODE_t (*USB_SETUP_DATA_RECEIVED_CALLBACK_t)(void);
+
 /**
  * @ingroup usb_protocol
  * @brief Function callback type USB_EVENT_CALLBACK_t.
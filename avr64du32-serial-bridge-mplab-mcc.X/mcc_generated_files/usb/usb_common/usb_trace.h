@@ -0,0 +1,71 @@
+/**
+ * USBTRACE USB Trace Hooks Header File
+ * @file usb_trace.h
+ * @ingroup usb_device_stack
+ * @brief This file contains the hooks that report USB stack activity to an application trace
+ * @version USB Device Stack Driver Version 1.0.0
+ */
+
+/*
+    (c) 2021 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+ */
+
+#ifndef USB_TRACE_H
+#define USB_TRACE_H
+
+#include <stdint.h>
+#include <usb_config.h>
+
+/**
+ * @ingroup usb_device_stack
+ * @enum USB_TRACE_EVENT_t
+ * @brief Events reported through USB_TRACE(), the payload is in the comment.
+ */
+typedef enum
+{
+    USB_TRACE_TRANSFER_START = 0, /**<Endpoint address, bit 7 set for IN*/
+    USB_TRACE_TRANSFER_END, /**<Endpoint address, bit 7 set for IN*/
+    USB_TRACE_CIRCBUF_FULL, /**<Low byte of the buffer address, the last free byte was used*/
+    USB_TRACE_CIRCBUF_EMPTY /**<Low byte of the buffer address, the last byte was read*/
+} USB_TRACE_EVENT_t;
+
+#if USB_TRACE_ENABLE
+/**
+ * @ingroup usb_device_stack
+ * @brief Records a stack event, called from the USB interrupt and the main loop. Implemented by the application.
+ * @param event - Event according to USB_TRACE_EVENT_t
+ * @param payload - Event payload
+ * @return None.
+ */
+void USB_TraceEvent(USB_TRACE_EVENT_t event, uint8_t payload);
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_TRACE
+ * @brief Reports an event with its payload to USB_TraceEvent().
+ */
+#define USB_TRACE(event, payload) USB_TraceEvent((event), (uint8_t)(payload))
+#else
+#define USB_TRACE(event, payload)
+#endif
+
+#endif /* USB_TRACE_H */
@@ -39,13 +39,74 @@
 #include <stdint.h>
 #include <usb_common_elements.h>
 
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_ENABLE
+ * @brief Adds a vendor-specific interface with its own bulk endpoints next to the CDC interfaces.
+ * Set to 0U to build a CDC-only device.
+ */
+#define USB_VENDOR_ENABLE 1U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_ENABLE
+ * @brief Adds a second CDC-ACM function with its own endpoints and buffers for streamed data,
+ * the first CDC function stays free for commands. Set to 0U for a single serial port.
+ */
+#define USB_CDC_DATA_PORT_ENABLE 1U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_STREAM_ENABLE
+ * @brief Adds alternate setting 1 to the vendor interface, with an isochronous IN endpoint that
+ * sends one packet of sampled data per frame. Needs USB_VENDOR_ENABLE, set to 0U to leave it out.
+ */
+#define USB_VENDOR_STREAM_ENABLE 1U
+
+#if USB_VENDOR_STREAM_ENABLE && !USB_VENDOR_ENABLE
+#error "The vendor stream needs the vendor interface"
+#endif
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_TRACE_ENABLE
+ * @brief Reports transfers and buffer full/empty transitions through USB_TraceEvent(), see usb_trace.h.
+ * The application then has to implement USB_TraceEvent(). Set to 0U to leave the hooks out.
+ */
+#define USB_TRACE_ENABLE 1U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_ENABLE
+ * @brief Adds a HID interface with 64-byte reports on interrupt endpoints polled every frame,
+ * usable without installing a driver. Set to 0U to leave it out.
+ */
+#define USB_HID_ENABLE 1U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_COMPOSITE_ENABLE
+ * @brief Set if the device has more than one function, each function is then described by an IAD.
+ */
+#define USB_COMPOSITE_ENABLE (USB_VENDOR_ENABLE || USB_CDC_DATA_PORT_ENABLE || USB_HID_ENABLE)
+
 /**
  * @ingroup usb_device_stack
  * @def USB_EP_NUM
  * @brief Limits the size of the endpoint table and transfer array in the RAM 
  * to 1 + the highest endpoint address used by the application.
  */
+#if USB_HID_ENABLE
+#define USB_EP_NUM 8U
+#elif USB_VENDOR_STREAM_ENABLE
+#define USB_EP_NUM 7U
+#elif USB_CDC_DATA_PORT_ENABLE
+#define USB_EP_NUM 6U
+#elif USB_VENDOR_ENABLE
+#define USB_EP_NUM 4U
+#else
 #define USB_EP_NUM 3U 
+#endif
 
 /**
  * @ingroup usb_device_stack
@@ -70,6 +131,14 @@
 #define INTERFACE0ALTERNATE0_INTERRUPT_EP1_IN 1U
 #define INTERFACE1ALTERNATE0_BULK_EP2_IN 2U
 #define INTERFACE1ALTERNATE0_BULK_EP2_OUT 2U
+#define INTERFACE2ALTERNATE0_BULK_EP3_IN 3U
+#define INTERFACE2ALTERNATE0_BULK_EP3_OUT 3U
+#define INTERFACE3ALTERNATE0_INTERRUPT_EP4_IN 4U
+#define INTERFACE4ALTERNATE0_BULK_EP5_IN 5U
+#define INTERFACE4ALTERNATE0_BULK_EP5_OUT 5U
+#define INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN 6U
+#define INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN 7U
+#define INTERFACE5ALTERNATE0_INTERRUPT_EP7_OUT 7U
 ///@}
 
 /**
@@ -81,8 +150,24 @@
 #define INTERFACE0ALTERNATE0_INTERRUPT_EP1_IN_SIZE 64U
 #define INTERFACE1ALTERNATE0_BULK_EP2_IN_SIZE 64U
 #define INTERFACE1ALTERNATE0_BULK_EP2_OUT_SIZE 64U
+#define INTERFACE2ALTERNATE0_BULK_EP3_IN_SIZE 64U
+#define INTERFACE2ALTERNATE0_BULK_EP3_OUT_SIZE 64U
+#define INTERFACE3ALTERNATE0_INTERRUPT_EP4_IN_SIZE 64U
+#define INTERFACE4ALTERNATE0_BULK_EP5_IN_SIZE 64U
+#define INTERFACE4ALTERNATE0_BULK_EP5_OUT_SIZE 64U
+#define INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN_SIZE 64U
+#define INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN_SIZE 64U
+#define INTERFACE5ALTERNATE0_INTERRUPT_EP7_OUT_SIZE 64U
 ///@}
 
+/**
+ * @ingroup usb_device_stack
+ * @def USB_TRANSFER_HANDLER_BUDGET
+ * @brief Maximum number of setup packets and completed transactions handled per call of USB_TransferHandler.
+ *        Covers one completion for each endpoint direction, plus a setup packet.
+ */
+#define USB_TRANSFER_HANDLER_BUDGET ((USB_EP_NUM * 2U) + 1U)
+
 /**
  * @ingroup usb_device_stack
  * @def USB_CDC_INTERRUPT_EP
@@ -90,6 +175,13 @@
  */
 #define USB_CDC_INTERRUPT_EP INTERFACE0ALTERNATE0_INTERRUPT_EP1_IN
 
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_COMM_INTERFACE
+ * @brief The number of the CDC communication interface, which owns the interrupt notification endpoint.
+ */
+#define USB_CDC_COMM_INTERFACE 0U
+
 /**
  * @ingroup usb_device_stack
  * @def USB_CDC_BULK_EP_IN
@@ -118,12 +210,19 @@
  */
 #define USB_CDC_TX_BUFFER_SIZE (2*MAX_ENDPOINT_SIZE_DEFAULT)
 
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_RX_QUEUE_PACKETS
+ * @brief Number of OUT packets the receive buffer can hold before the host is NAKed.
+ */
+#define USB_CDC_RX_QUEUE_PACKETS 4U
+
 /**
  * @ingroup usb_device_stack
  * @def USB_CDC_RX_BUFFER_SIZE
- * @brief Macro for the receive buffer size.
+ * @brief Macro for the receive buffer size. One extra byte is needed, as a full circular buffer keeps one slot free.
  */
-#define USB_CDC_RX_BUFFER_SIZE (2*MAX_ENDPOINT_SIZE_DEFAULT)
+#define USB_CDC_RX_BUFFER_SIZE ((USB_CDC_RX_QUEUE_PACKETS * MAX_ENDPOINT_SIZE_DEFAULT) + 1U)
 
 /**
  * @ingroup usb_device_stack
@@ -139,12 +238,189 @@
  */
 #define USB_CDC_UNION_SUBORDINATE_NUM 0u
 
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_INTERFACE
+ * @brief The number of the vendor-specific interface.
+ */
+#define USB_VENDOR_INTERFACE 2U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_BULK_EP_IN
+ * @brief The address for the vendor bulk IN endpoint.
+ */
+#define USB_VENDOR_BULK_EP_IN INTERFACE2ALTERNATE0_BULK_EP3_IN
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_BULK_EP_OUT
+ * @brief The address for the vendor bulk OUT endpoint.
+ */
+#define USB_VENDOR_BULK_EP_OUT INTERFACE2ALTERNATE0_BULK_EP3_OUT
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_TRANSFER_SIZE
+ * @brief Size of one vendor bulk transfer. The endpoints use multipacket, so a transfer
+ * of several packets only completes once, must be a multiple of the endpoint size.
+ */
+#define USB_VENDOR_TRANSFER_SIZE (4U * INTERFACE2ALTERNATE0_BULK_EP3_OUT_SIZE)
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_BUFFER_NUM
+ * @brief Number of vendor transfer buffers, the next OUT transfer runs while the previous data is sent back.
+ */
+#define USB_VENDOR_BUFFER_NUM 2U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_MS_OS_20_VENDOR_CODE
+ * @brief bRequest of the vendor request that reads the Microsoft OS 2.0 descriptor set.
+ */
+#define USB_VENDOR_MS_OS_20_VENDOR_CODE 0x20U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_STREAM_ALTERNATE
+ * @brief The alternate setting of the vendor interface that adds the isochronous stream endpoint.
+ * Alternate setting 0 reserves no isochronous bandwidth.
+ */
+#define USB_VENDOR_STREAM_ALTERNATE 1U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_STREAM_EP_IN
+ * @brief The address for the vendor isochronous IN endpoint.
+ */
+#define USB_VENDOR_STREAM_EP_IN INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_VENDOR_STREAM_PACKET_SIZE
+ * @brief Size of the stream packet sent in each frame, header included. Isochronous endpoint sizes
+ * must be a power of two, or 1023.
+ */
+#define USB_VENDOR_STREAM_PACKET_SIZE INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN_SIZE
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_COMM_INTERFACE
+ * @brief The number of the communication interface of the CDC data port, which owns its interrupt notification endpoint.
+ * The data port follows the command port and the vendor interface.
+ */
+#if USB_VENDOR_ENABLE
+#define USB_CDC_DATA_PORT_COMM_INTERFACE 3U
+#else
+#define USB_CDC_DATA_PORT_COMM_INTERFACE 2U
+#endif
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_DATA_INTERFACE
+ * @brief The number of the data interface of the CDC data port.
+ */
+#define USB_CDC_DATA_PORT_DATA_INTERFACE (USB_CDC_DATA_PORT_COMM_INTERFACE + 1U)
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_INTERRUPT_EP
+ * @brief The address for the CDC data port interrupt notification endpoint.
+ */
+#define USB_CDC_DATA_PORT_INTERRUPT_EP INTERFACE3ALTERNATE0_INTERRUPT_EP4_IN
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_BULK_EP_IN
+ * @brief The address for the CDC data port bulk IN endpoint.
+ */
+#define USB_CDC_DATA_PORT_BULK_EP_IN INTERFACE4ALTERNATE0_BULK_EP5_IN
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_BULK_EP_OUT
+ * @brief The address for the CDC data port bulk OUT endpoint.
+ */
+#define USB_CDC_DATA_PORT_BULK_EP_OUT INTERFACE4ALTERNATE0_BULK_EP5_OUT
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_TX_BUFFER_SIZE
+ * @brief Macro for the data port transmit buffer size. The IN endpoint uses multipacket,
+ * so a full buffer is sent as one transfer.
+ */
+#define USB_CDC_DATA_PORT_TX_BUFFER_SIZE (4U * INTERFACE4ALTERNATE0_BULK_EP5_IN_SIZE)
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_RX_QUEUE_PACKETS
+ * @brief Number of OUT packets the data port receive buffer can hold before the host is NAKed.
+ */
+#define USB_CDC_DATA_PORT_RX_QUEUE_PACKETS 4U
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_RX_PACKET_SIZE
+ * @brief Macro for the data port receive packet size.
+ */
+#define USB_CDC_DATA_PORT_RX_PACKET_SIZE INTERFACE4ALTERNATE0_BULK_EP5_OUT_SIZE
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_CDC_DATA_PORT_RX_BUFFER_SIZE
+ * @brief Macro for the data port receive buffer size. One extra byte is needed, as a full circular buffer keeps one slot free.
+ */
+#define USB_CDC_DATA_PORT_RX_BUFFER_SIZE ((USB_CDC_DATA_PORT_RX_QUEUE_PACKETS * USB_CDC_DATA_PORT_RX_PACKET_SIZE) + 1U)
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_INTERFACE
+ * @brief The number of the HID interface, which follows all other functions.
+ */
+#if USB_CDC_DATA_PORT_ENABLE
+#define USB_HID_INTERFACE (USB_CDC_DATA_PORT_DATA_INTERFACE + 1U)
+#elif USB_VENDOR_ENABLE
+#define USB_HID_INTERFACE 3U
+#else
+#define USB_HID_INTERFACE 2U
+#endif
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_INTERRUPT_EP_IN
+ * @brief The address for the HID interrupt IN endpoint, which sends the input reports.
+ */
+#define USB_HID_INTERRUPT_EP_IN INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_INTERRUPT_EP_OUT
+ * @brief The address for the HID interrupt OUT endpoint, which receives the output reports.
+ */
+#define USB_HID_INTERRUPT_EP_OUT INTERFACE5ALTERNATE0_INTERRUPT_EP7_OUT
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_REPORT_SIZE
+ * @brief Size of the input and output reports, one packet each.
+ */
+#define USB_HID_REPORT_SIZE INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN_SIZE
+
 /**
  * @ingroup usb_device_stack
  * @def USB_INTERFACE_NUM
  * @brief The number of interfaces used by a configuration, excluding alternate interfaces.
  */
+#if USB_HID_ENABLE
+#define USB_INTERFACE_NUM (USB_HID_INTERFACE + 1U)
+#elif USB_CDC_DATA_PORT_ENABLE
+#define USB_INTERFACE_NUM (USB_CDC_DATA_PORT_DATA_INTERFACE + 1U)
+#elif USB_VENDOR_ENABLE
+#define USB_INTERFACE_NUM 3U
+#else
 #define USB_INTERFACE_NUM 2U
+#endif
 
 /**
  * @ingroup usb_device_stack
@@ -171,6 +447,19 @@ static const USB_EP_STATIC_CONFIG_BITS_t endpointStaticConfig [USB_EP_NUM] = {
     [0] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 1, .InAzlpEnable = 0, .OutMultipktEnable = 1, .OutAzlpEnable = 0},
     [1] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 0, .InAzlpEnable = 0},
     [2] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 0, .InAzlpEnable = 0, .OutMultipktEnable = 0, .OutAzlpEnable = 0},
+#if USB_VENDOR_ENABLE
+    [3] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 1, .InAzlpEnable = 0, .OutMultipktEnable = 1, .OutAzlpEnable = 0},
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+    [4] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 0, .InAzlpEnable = 0},
+    [5] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 1, .InAzlpEnable = 0, .OutMultipktEnable = 0, .OutAzlpEnable = 0},
+#endif
+#if USB_VENDOR_STREAM_ENABLE
+    [6] = {.InTrncInterruptEnable = 1, .InMultipktEnable = 0, .InAzlpEnable = 0},
+#endif
+#if USB_HID_ENABLE
+    [7] = {.InTrncInterruptEnable = 1, .OutTrncInterruptEnable = 1, .InMultipktEnable = 0, .InAzlpEnable = 0, .OutMultipktEnable = 0, .OutAzlpEnable = 0},
+#endif
 };
 
 #endif // USB_CONFIG_H
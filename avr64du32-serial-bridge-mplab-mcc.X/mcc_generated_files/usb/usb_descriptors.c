@@ -40,10 +40,20 @@ static USB_DEVICE_DESCRIPTOR_t deviceDescriptor = {
         .bLength = sizeof(USB_DEVICE_DESCRIPTOR_t),
         .bDescriptorType = USB_DESCRIPTOR_TYPE_DEVICE,
     },
+#if USB_VENDOR_ENABLE
+    .bcdUSB = 0x201,            // USB 2.0 with BOS descriptor
+#else
     .bcdUSB = 0x200,            // USB 2.0
+#endif
+#if USB_COMPOSITE_ENABLE
+    .bDeviceClass = CLASS_IAD,          // Composite device, functions are described by IADs
+    .bDeviceSubClass = SUB_CLASS_IAD,
+    .bDeviceProtocol = PROTOCOL_IAD,
+#else
     .bDeviceClass = USB_CDC_DEVICE_CLASS,        // CDC has the option to identify with CDC Class on device level
     .bDeviceSubClass = 0x00,            // Not defined in Device Descriptor level
     .bDeviceProtocol = 0x00,            // Not defined in Device Descriptor level
+#endif
     .bMaxPacketSize0 = USB_EP0_SIZE,    // EP0 size
     .idVendor = 0x04D8,            // MCHP VID
     .idProduct = 0x0B15,          // PID 0x0010-0x002F reserved for testing/non-public demos
@@ -54,6 +64,24 @@ static USB_DEVICE_DESCRIPTOR_t deviceDescriptor = {
     .bNumConfigurations = 0x01          // Number of configurations 
 };
 
+#if USB_HID_ENABLE
+uint8_t hidReportDescriptor[USB_HID_REPORT_DESCRIPTOR_SIZE] = {
+    0x06, 0x00, 0xFF,               // Usage Page (Vendor Defined 0xFF00)
+    0x09, 0x01,                     // Usage (0x01)
+    0xA1, 0x01,                     // Collection (Application)
+    0x15, 0x00,                     //   Logical Minimum (0)
+    0x26, 0xFF, 0x00,               //   Logical Maximum (255)
+    0x75, 0x08,                     //   Report Size (8)
+    0x95, USB_HID_REPORT_SIZE,      //   Report Count (64)
+    0x09, 0x01,                     //   Usage (0x01)
+    0x81, 0x02,                     //   Input (Data, Variable, Absolute)
+    0x95, USB_HID_REPORT_SIZE,      //   Report Count (64)
+    0x09, 0x01,                     //   Usage (0x01)
+    0x91, 0x02,                     //   Output (Data, Variable, Absolute)
+    0xC0,                           // End Collection
+};
+#endif
+
 static USB_APPLICATION_CONFIGURATION_t configurationDescriptor = {
     .Config1 =
     {
@@ -71,6 +99,22 @@ static USB_APPLICATION_CONFIGURATION_t configurationDescriptor = {
             .bmAttributes = USB_CONFIG_ATTR_MUST_SET | USB_CONFIG_ATTR_BUS_POWERED,
             .bMaxPower = USB_CONFIG_MAX_POWER(2),
         },
+#if USB_COMPOSITE_ENABLE
+        .Interface0Association =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ASSOCIATION_DESC_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_IAD,
+            },
+            .bFirstInterface = 0U,
+            .bInterfaceCount = 2U, // CDC communication and data interfaces
+            .bFunctionClass = USB_CDC_COMMUNICATION_INTERFACE_CLASS,
+            .bFunctionSubClass = USB_CDC_COMM_SUBCLASS_ABSTRACT_CONTROL_MODEL,
+            .bFunctionProtocol = USB_CDC_COMM_NO_PROTOCOL,
+            .iFunction = 0U,
+        },
+#endif
         .Interface0Alternate0 =
         {
             .header =
@@ -164,8 +208,405 @@ static USB_APPLICATION_CONFIGURATION_t configurationDescriptor = {
             .wMaxPacketSize = INTERFACE1ALTERNATE0_BULK_EP2_OUT_SIZE,
             .bInterval = 0U,
         },
+#if USB_VENDOR_ENABLE
+        .Interface2Alternate0 =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_INTERFACE_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_INTERFACE,
+            },
+            .bInterfaceNumber = USB_VENDOR_INTERFACE,
+            .bAlternateSetting = 0U,
+            .bNumEndpoints = 2U,
+            .bInterfaceClass = USB_VENDOR_INTERFACE_CLASS, // Vendor
+            .bInterfaceSubClass = 0U,
+            .bInterfaceProtocol = 0U,
+            .iInterface = 0U,
+        },
+        .Interface2Alternate0_Endpoint3IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE2ALTERNATE0_BULK_EP3_IN,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE2ALTERNATE0_BULK_EP3_IN_SIZE,
+            .bInterval = 0U,
+        },
+        .Interface2Alternate0_Endpoint3OUT =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_OUT,
+                .address = INTERFACE2ALTERNATE0_BULK_EP3_OUT,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE2ALTERNATE0_BULK_EP3_OUT_SIZE,
+            .bInterval = 0U,
+        },
+#if USB_VENDOR_STREAM_ENABLE
+        .Interface2Alternate1 =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_INTERFACE_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_INTERFACE,
+            },
+            .bInterfaceNumber = USB_VENDOR_INTERFACE,
+            .bAlternateSetting = USB_VENDOR_STREAM_ALTERNATE,
+            .bNumEndpoints = 3U,
+            .bInterfaceClass = USB_VENDOR_INTERFACE_CLASS, // Vendor
+            .bInterfaceSubClass = 0U,
+            .bInterfaceProtocol = 0U,
+            .iInterface = 0U,
+        },
+        .Interface2Alternate1_Endpoint3IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE2ALTERNATE0_BULK_EP3_IN,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE2ALTERNATE0_BULK_EP3_IN_SIZE,
+            .bInterval = 0U,
+        },
+        .Interface2Alternate1_Endpoint3OUT =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_OUT,
+                .address = INTERFACE2ALTERNATE0_BULK_EP3_OUT,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE2ALTERNATE0_BULK_EP3_OUT_SIZE,
+            .bInterval = 0U,
+        },
+        .Interface2Alternate1_Endpoint6IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN,
+            },
+            .bmAttributes =
+            {
+                .type = ISOCHRONOUS,
+                .synchronisation = 3U, // Synchronous, one packet per SOF
+                .usage = 0U, // Data
+            },
+            .wMaxPacketSize = INTERFACE2ALTERNATE1_ISOCHRONOUS_EP6_IN_SIZE,
+            .bInterval = 1U, // Every frame
+        },
+#endif
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+        .Interface3Association =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ASSOCIATION_DESC_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_IAD,
+            },
+            .bFirstInterface = USB_CDC_DATA_PORT_COMM_INTERFACE,
+            .bInterfaceCount = 2U, // CDC communication and data interfaces of the data port
+            .bFunctionClass = USB_CDC_COMMUNICATION_INTERFACE_CLASS,
+            .bFunctionSubClass = USB_CDC_COMM_SUBCLASS_ABSTRACT_CONTROL_MODEL,
+            .bFunctionProtocol = USB_CDC_COMM_NO_PROTOCOL,
+            .iFunction = 0U,
+        },
+        .Interface3Alternate0 =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_INTERFACE_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_INTERFACE,
+            },
+            .bInterfaceNumber = USB_CDC_DATA_PORT_COMM_INTERFACE,
+            .bAlternateSetting = 0U,
+            .bNumEndpoints = 1U,
+            .bInterfaceClass = USB_CDC_COMMUNICATION_INTERFACE_CLASS, // CDC
+            .bInterfaceSubClass = USB_CDC_COMM_SUBCLASS_ABSTRACT_CONTROL_MODEL,
+            .bInterfaceProtocol = USB_CDC_COMM_NO_PROTOCOL,
+            .iInterface = 0U,
+        },
+        .Interface3Alternate0_Endpoint4IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE3ALTERNATE0_INTERRUPT_EP4_IN,
+            },
+            .bmAttributes =
+            {
+                .type = INTERRUPT,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE3ALTERNATE0_INTERRUPT_EP4_IN_SIZE,
+            .bInterval = 1U,
+        },
+        .Interface4Alternate0 =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_INTERFACE_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_INTERFACE,
+            },
+            .bInterfaceNumber = USB_CDC_DATA_PORT_DATA_INTERFACE,
+            .bAlternateSetting = 0U,
+            .bNumEndpoints = 2U,
+            .bInterfaceClass = USB_CDC_DATA_INTERFACE_CLASS, // CDC
+            .bInterfaceSubClass = USB_CDC_DATA_NO_SUBCLASS,
+            .bInterfaceProtocol = USB_CDC_DATA_NO_PROTOCOL,
+            .iInterface = 0U,
+        },
+        .Interface4Alternate0_Endpoint5IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE4ALTERNATE0_BULK_EP5_IN,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE4ALTERNATE0_BULK_EP5_IN_SIZE,
+            .bInterval = 0U,
+        },
+        .Interface4Alternate0_Endpoint5OUT =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_OUT,
+                .address = INTERFACE4ALTERNATE0_BULK_EP5_OUT,
+            },
+            .bmAttributes =
+            {
+                .type = BULK,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE4ALTERNATE0_BULK_EP5_OUT_SIZE,
+            .bInterval = 0U,
+        },
+#endif
+#if USB_HID_ENABLE
+        .Interface5Alternate0 =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_INTERFACE_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_INTERFACE,
+            },
+            .bInterfaceNumber = USB_HID_INTERFACE,
+            .bAlternateSetting = 0U,
+            .bNumEndpoints = 2U,
+            .bInterfaceClass = USB_HID_INTERFACE_CLASS, // HID
+            .bInterfaceSubClass = USB_HID_NO_SUBCLASS,
+            .bInterfaceProtocol = USB_HID_NO_PROTOCOL,
+            .iInterface = 0U,
+        },
+        .Interface5Alternate0_HID =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_HID_DESCRIPTOR_t),
+                .bDescriptorType = USB_HID_DESCRIPTOR_TYPE_HID,
+            },
+            .bcdHID = USB_HID_BCD_VERSION,
+            .bCountryCode = 0U, // Not localized
+            .bNumDescriptors = 1U,
+            .bReportDescriptorType = USB_HID_DESCRIPTOR_TYPE_REPORT,
+            .wReportDescriptorLength = sizeof (hidReportDescriptor),
+        },
+        .Interface5Alternate0_Endpoint7IN =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_IN,
+                .address = INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN,
+            },
+            .bmAttributes =
+            {
+                .type = INTERRUPT,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE5ALTERNATE0_INTERRUPT_EP7_IN_SIZE,
+            .bInterval = 1U,
+        },
+        .Interface5Alternate0_Endpoint7OUT =
+        {
+            .header =
+            {
+                .bLength = sizeof (USB_ENDPOINT_DESCRIPTOR_t),
+                .bDescriptorType = USB_DESCRIPTOR_TYPE_ENDPOINT,
+            },
+            .bEndpointAddress =
+            {
+                .direction = USB_EP_DIR_OUT,
+                .address = INTERFACE5ALTERNATE0_INTERRUPT_EP7_OUT,
+            },
+            .bmAttributes =
+            {
+                .type = INTERRUPT,
+                .synchronisation = 0U, // None
+                .usage = 0U, // None
+            },
+            .wMaxPacketSize = INTERFACE5ALTERNATE0_INTERRUPT_EP7_OUT_SIZE,
+            .bInterval = 1U,
+        },
+#endif
+    },
+};
+
+#if USB_HID_ENABLE
+USB_HID_DESCRIPTOR_t *hidDescriptorPtr = &configurationDescriptor.Config1.Interface5Alternate0_HID;
+#endif
+
+#if USB_VENDOR_ENABLE
+USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t msOS20DescriptorSet = {
+    .header =
+    {
+        .wLength = sizeof (USB_MS_OS_20_SET_HEADER_DESCRIPTOR_t),
+        .wDescriptorType = USB_MS_OS_20_SET_HEADER_DESCRIPTOR,
+        .dwWindowsVersion = USB_MS_OS_20_WINDOWS_VERSION_8_1,
+        .wTotalLength = sizeof (USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t),
+    },
+    .configurationSubset =
+    {
+        .wLength = sizeof (USB_MS_OS_20_CONFIGURATION_SUBSET_HEADER_t),
+        .wDescriptorType = USB_MS_OS_20_SUBSET_HEADER_CONFIGURATION,
+        .bConfigurationValue = 0U, // Index of Config1
+        .bReserved = 0U,
+        .wTotalLength = sizeof (USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t) - sizeof (USB_MS_OS_20_SET_HEADER_DESCRIPTOR_t),
+    },
+    .vendorFunctionSubset =
+    {
+        .wLength = sizeof (USB_MS_OS_20_FUNCTION_SUBSET_HEADER_t),
+        .wDescriptorType = USB_MS_OS_20_SUBSET_HEADER_FUNCTION,
+        .bFirstInterface = USB_VENDOR_INTERFACE,
+        .bReserved = 0U,
+        .wSubsetLength = sizeof (USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t) - offsetof(USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t, vendorFunctionSubset),
+    },
+    .compatibleID =
+    {
+        .wLength = sizeof (USB_MS_OS_20_COMPATIBLE_ID_DESCRIPTOR_t),
+        .wDescriptorType = USB_MS_OS_20_FEATURE_COMPATIBLE_ID,
+        .CompatibleID = "WINUSB",
+        .SubCompatibleID = "",
+    },
+    .interfaceGUIDHeader =
+    {
+        .wLength = sizeof (USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t) - offsetof(USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t, interfaceGUIDHeader),
+        .wDescriptorType = USB_MS_OS_20_FEATURE_REG_PROPERTY,
+        .wPropertyDataType = USB_MS_OS_20_REG_MULTI_SZ,
+        .wPropertyNameLength = sizeof (msOS20DescriptorSet.interfaceGUIDName),
+    },
+    .interfaceGUIDName = STRING_VENDOR_INTERFACE_GUID_PROPERTY,
+    .interfaceGUIDDataLength = sizeof (msOS20DescriptorSet.interfaceGUID),
+    .interfaceGUID = STRING_VENDOR_INTERFACE_GUID,
+};
+
+static USB_APPLICATION_BOS_DESCRIPTOR_t bosDescriptor = {
+    .bos =
+    {
+        .header =
+        {
+            .bLength = sizeof (USB_DEV_BOS_DESC_t),
+            .bDescriptorType = USB_DESCRIPTOR_TYPE_BOS,
+        },
+        .wTotalLength = sizeof (USB_APPLICATION_BOS_DESCRIPTOR_t),
+        .bNumDeviceCaps = 1U,
+    },
+    .msOS20Platform =
+    {
+        .header =
+        {
+            .bLength = sizeof (USB_MS_OS_20_PLATFORM_CAPABILITY_DESCRIPTOR_t),
+            .bDescriptorType = USB_DESCRIPTOR_TYPE_DEVICE_CAPABILITY,
+        },
+        .bDevCapabilityType = USB_DEVICE_CAPABILITY_PLATFORM,
+        .bReserved = 0U,
+        .PlatformCapabilityUUID = USB_MS_OS_20_PLATFORM_CAPABILITY_UUID,
+        .dwWindowsVersion = USB_MS_OS_20_WINDOWS_VERSION_8_1,
+        .wMSOSDescriptorSetTotalLength = sizeof (USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t),
+        .bMS_VendorCode = USB_VENDOR_MS_OS_20_VENDOR_CODE,
+        .bAltEnumCode = 0U,
     },
 };
+#endif
 
 static USB_STRING_LANG_ID_DESCRIPTOR_t langIDDescriptor  = {
     .header =
@@ -201,7 +642,11 @@ static USB_APPLICATION_STRING_DESCRIPTORS_t stringDescriptors = {
 USB_DESCRIPTOR_POINTERS_t descriptorPointers = {
     .devicePtr = (USB_DEVICE_DESCRIPTOR_t *) & deviceDescriptor,
     .configurationsPtr = (USB_CONFIGURATION_DESCRIPTOR_t *) & configurationDescriptor,
+#if USB_VENDOR_ENABLE
+    .deviceBOSptr = (USB_DEV_BOS_DESC_t *) & bosDescriptor,
+#else
     .deviceBOSptr = NULL,
+#endif
     .langIDptr = &langIDDescriptor,
     .stringPtrs =
     {
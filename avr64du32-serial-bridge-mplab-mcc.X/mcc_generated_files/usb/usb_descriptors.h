@@ -38,6 +38,12 @@
 #include "usb_config.h"
 
 #include <usb_protocol_cdc.h>
+#if USB_VENDOR_ENABLE
+#include <usb_protocol_vendor.h>
+#endif
+#if USB_HID_ENABLE
+#include <usb_protocol_hid.h>
+#endif
 
 /**
  * @ingroup usb_device_stack
@@ -67,6 +73,28 @@
  */
 #define STRING_SERIAL       L"1"
 
+/**
+ * @ingroup usb_device_stack
+ * @def STRING_VENDOR_INTERFACE_GUID
+ * @brief Device interface GUID of the vendor interface, used by WinUSB clients to find the device.
+ * The trailing null character ends the REG_MULTI_SZ list.
+ */
+#define STRING_VENDOR_INTERFACE_GUID L"{8A3C2F5E-6B1D-4E7A-9C04-2D5B7F10E3A6}\0"
+
+/**
+ * @ingroup usb_device_stack
+ * @def STRING_VENDOR_INTERFACE_GUID_PROPERTY
+ * @brief Registry property name of the device interface GUID.
+ */
+#define STRING_VENDOR_INTERFACE_GUID_PROPERTY L"DeviceInterfaceGUIDs"
+
+/**
+ * @ingroup usb_device_stack
+ * @def USB_HID_REPORT_DESCRIPTOR_SIZE
+ * @brief Size of hidReportDescriptor in bytes.
+ */
+#define USB_HID_REPORT_DESCRIPTOR_SIZE 27U
+
 /**
  * @ingroup usb_device_stack
  * @struct USB_APPLICATION_CONFIGURATION1_struct
@@ -75,11 +103,39 @@
 typedef struct USB_APPLICATION_CONFIGURATION1_struct
 {
     USB_CONFIGURATION_DESCRIPTOR_t Configuration;
+#if USB_COMPOSITE_ENABLE
+    USB_ASSOCIATION_DESC_t Interface0Association;
+#endif
     USB_INTERFACE_DESCRIPTOR_t Interface0Alternate0;
     USB_ENDPOINT_DESCRIPTOR_t Interface0Alternate0_Endpoint1IN;
     USB_INTERFACE_DESCRIPTOR_t Interface1Alternate0;
     USB_ENDPOINT_DESCRIPTOR_t Interface1Alternate0_Endpoint2IN;
     USB_ENDPOINT_DESCRIPTOR_t Interface1Alternate0_Endpoint2OUT;
+#if USB_VENDOR_ENABLE
+    USB_INTERFACE_DESCRIPTOR_t Interface2Alternate0;
+    USB_ENDPOINT_DESCRIPTOR_t Interface2Alternate0_Endpoint3IN;
+    USB_ENDPOINT_DESCRIPTOR_t Interface2Alternate0_Endpoint3OUT;
+#if USB_VENDOR_STREAM_ENABLE
+    USB_INTERFACE_DESCRIPTOR_t Interface2Alternate1;
+    USB_ENDPOINT_DESCRIPTOR_t Interface2Alternate1_Endpoint3IN;
+    USB_ENDPOINT_DESCRIPTOR_t Interface2Alternate1_Endpoint3OUT;
+    USB_ENDPOINT_DESCRIPTOR_t Interface2Alternate1_Endpoint6IN;
+#endif
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+    USB_ASSOCIATION_DESC_t Interface3Association;
+    USB_INTERFACE_DESCRIPTOR_t Interface3Alternate0;
+    USB_ENDPOINT_DESCRIPTOR_t Interface3Alternate0_Endpoint4IN;
+    USB_INTERFACE_DESCRIPTOR_t Interface4Alternate0;
+    USB_ENDPOINT_DESCRIPTOR_t Interface4Alternate0_Endpoint5IN;
+    USB_ENDPOINT_DESCRIPTOR_t Interface4Alternate0_Endpoint5OUT;
+#endif
+#if USB_HID_ENABLE
+    USB_INTERFACE_DESCRIPTOR_t Interface5Alternate0;
+    USB_HID_DESCRIPTOR_t Interface5Alternate0_HID;
+    USB_ENDPOINT_DESCRIPTOR_t Interface5Alternate0_Endpoint7IN;
+    USB_ENDPOINT_DESCRIPTOR_t Interface5Alternate0_Endpoint7OUT;
+#endif
 } USB_APPLICATION_CONFIGURATION1_t;
 
 /**
@@ -107,6 +163,59 @@ typedef struct USB_APPLICATION_STRING_DESCRIPTORS_struct
     wchar_t serial[DESCRIPTOR_STRING_LENGTH(STRING_SERIAL)]; 
 } USB_APPLICATION_STRING_DESCRIPTORS_t;
 
+#if USB_VENDOR_ENABLE
+/**
+ * @ingroup usb_device_stack
+ * @struct USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_struct
+ * @brief Microsoft OS 2.0 descriptor set, binds WinUSB to the vendor interface.
+ */
+typedef struct USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_struct
+{
+    USB_MS_OS_20_SET_HEADER_DESCRIPTOR_t header;
+    USB_MS_OS_20_CONFIGURATION_SUBSET_HEADER_t configurationSubset;
+    USB_MS_OS_20_FUNCTION_SUBSET_HEADER_t vendorFunctionSubset;
+    USB_MS_OS_20_COMPATIBLE_ID_DESCRIPTOR_t compatibleID;
+    USB_MS_OS_20_REGISTRY_PROPERTY_HEADER_t interfaceGUIDHeader;
+    wchar_t interfaceGUIDName[sizeof (STRING_VENDOR_INTERFACE_GUID_PROPERTY) / sizeof (wchar_t)];
+    uint16_t interfaceGUIDDataLength;
+    wchar_t interfaceGUID[sizeof (STRING_VENDOR_INTERFACE_GUID) / sizeof (wchar_t)];
+} USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t;
+
+/**
+ * @ingroup usb_device_stack
+ * @struct USB_APPLICATION_BOS_DESCRIPTOR_struct
+ * @brief BOS descriptor and its device capabilities.
+ */
+typedef struct USB_APPLICATION_BOS_DESCRIPTOR_struct
+{
+    USB_DEV_BOS_DESC_t bos;
+    USB_MS_OS_20_PLATFORM_CAPABILITY_DESCRIPTOR_t msOS20Platform;
+} USB_APPLICATION_BOS_DESCRIPTOR_t;
+
+/**
+ * @ingroup usb_device_stack
+ * @struct msOS20DescriptorSet
+ * @brief Microsoft OS 2.0 descriptor set, returned by the vendor request announced in the BOS.
+ */
+extern USB_APPLICATION_MS_OS_20_DESCRIPTOR_SET_t msOS20DescriptorSet;
+#endif
+
+#if USB_HID_ENABLE
+/**
+ * @ingroup usb_device_stack
+ * @struct hidReportDescriptor
+ * @brief Report descriptor of the HID interface, one vendor-defined input and output report without report ID.
+ */
+extern uint8_t hidReportDescriptor[USB_HID_REPORT_DESCRIPTOR_SIZE];
+
+/**
+ * @ingroup usb_device_stack
+ * @struct hidDescriptorPtr
+ * @brief Pointer to the HID descriptor of the HID interface, in the configuration descriptor.
+ */
+extern USB_HID_DESCRIPTOR_t *hidDescriptorPtr;
+#endif
+
 /**
  * @ingroup usb_device_stack
  * @struct descriptorPointers
@@ -69,6 +69,11 @@ RETURN_CODE_t USBDevice_StatusGet(void)
     return usbStatus;
 }
 
+void USBDevice_StatusClear(void)
+{
+    usbStatus = SUCCESS;
+}
+
 static void USBDevice_TransferHandler(void)
 {
     usbStatus = USB_TransferHandler();
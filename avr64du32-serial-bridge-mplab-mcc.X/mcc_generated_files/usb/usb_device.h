@@ -60,6 +60,14 @@ RETURN_CODE_t USBDevice_Handle(void);
  */ 
 RETURN_CODE_t USBDevice_StatusGet(void);
 
+/**
+ * @ingroup usb_device_stack
+ * @brief Clears a stored error so USBDevice_Handle runs the stack again after recovery.
+ * @param None.
+ * @return None.
+ */ 
+void USBDevice_StatusClear(void);
+
 #endif // USB_DEVICE_H
 /**
  End of File
@@ -223,6 +223,9 @@ RETURN_CODE_t USB_ControlSetupReceived(void)
         // Copies setup packet out of buffer to make it available for a data stage.
         (void)memcpy((uint8_t *)(&controlTransfer.setupRequest), controlTransfer.buffer, sizeof(USB_SETUP_REQUEST_t));
 
+        // The data stage callback is only kept if the setup processing registers it again.
+        controlTransfer.dataReceivedCallback = NULL;
+
         // The processSetupCallback is in most cases the USB_SetupProcess function in usb_core.c.
         if (controlTransfer.processSetupCallback != NULL)
         {
@@ -363,9 +366,20 @@ RETURN_CODE_t USB_ControlTransactionComplete(USB_PIPE_t pipe)
                 controlTransfer.totalBytesTransferred += bytesReceived;
                 if (controlTransfer.transferDataSize == controlTransfer.totalBytesTransferred)
                 {
+                    if ((controlTransfer.dataReceivedCallback != NULL) && (SUCCESS != controlTransfer.dataReceivedCallback()))
+                    {
+                        // Data rejected by the application, stalls the status stage.
+                        controlTransfer.status = USB_CONTROL_STALL_REQ;
+                        USB_EndpointInStall(0);
+                        USB_EndpointOutStall(0);
 
-                    // Data stage is complete, sends an IN ZLP for status stage.
-                    status = USB_ControlTransferZLP(USB_REQUEST_DIR_IN);
+                        status = SUCCESS;
+                    }
+                    else
+                    {
+                        // Data stage is complete, sends an IN ZLP for status stage.
+                        status = USB_ControlTransferZLP(USB_REQUEST_DIR_IN);
+                    }
                 }
                 else
                 {
@@ -490,6 +504,7 @@ RETURN_CODE_t USB_ControlTransferReset(void)
         // Resets the control transfer variables
         controlTransfer.endOfRequestCallback = NULL;
         controlTransfer.overUnderRunCallback = NULL;
+        controlTransfer.dataReceivedCallback = NULL;
         controlTransfer.transferDataSize = 0u;
         controlTransfer.status = USB_CONTROL_SETUP;
     }
@@ -557,6 +572,11 @@ void USB_ControlOverUnderRunCallbackRegister(USB_SETUP_OVERUNDERRUN_CALLBACK_t c
     controlTransfer.overUnderRunCallback = callback;
 }
 
+void USB_ControlDataReceivedCallbackRegister(USB_SETUP_DATA_RECEIVED_CALLBACK_t callback)
+{
+    controlTransfer.dataReceivedCallback = callback;
+}
+
 RETURN_CODE_t USB_ControlProcessOverUnderflow(uint8_t overunderflow)
 {
     RETURN_CODE_t status = UNINITIALIZED;
@@ -639,6 +659,23 @@ void USB_PeripheralInitialize(void)
     }
 }
 
+void USB_PeripheralBusReset(void)
+{
+    // The peripheral stays enabled and attached, only the state owned by the host is cleared.
+    USB_DeviceAddressReset();
+    USB_FifoReadPointerReset();
+    USB_FifoWritePointerReset();
+    USB_InterruptFlagsClear();
+    // Reset endpoints table
+    for (uint8_t endpoint = 0; endpoint < (uint8_t)USB_EP_NUM; endpoint++)
+    {
+        endpointTable.EP[endpoint].OUT.CTRL = 0;
+        endpointTable.EP[endpoint].OUT.STATUS = 0;
+        endpointTable.EP[endpoint].IN.CTRL = 0;
+        endpointTable.EP[endpoint].IN.STATUS = 0;
+    }
+}
+
 void USB_PeripheralDisable(void)
 {
     USB_Disable();
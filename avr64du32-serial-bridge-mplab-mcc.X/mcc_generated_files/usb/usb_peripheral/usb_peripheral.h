@@ -56,6 +56,7 @@ typedef struct USB_CONTROL_TRANSFER_struct
     USB_SETUP_PROCESS_CALLBACK_t processSetupCallback;      /**<Callback to call during setup process*/
     USB_SETUP_OVERUNDERRUN_CALLBACK_t overUnderRunCallback; /**<Callback to call on a control overrun or underrun*/
     USB_SETUP_ENDOFREQUEST_CALLBACK_t endOfRequestCallback; /**<Callback to call when a setup request is complete*/
+    USB_SETUP_DATA_RECEIVED_CALLBACK_t dataReceivedCallback; /**<Callback to call when the OUT data stage is complete*/
     USB_SETUP_REQUEST_t setupRequest;                       /**<Setup request packet*/
 } USB_CONTROL_TRANSFER_t;
 
@@ -301,6 +302,14 @@ void USB_ControlProcessSetupCallbackRegister(USB_SETUP_PROCESS_CALLBACK_t callba
  */
 void USB_ControlOverUnderRunCallbackRegister(USB_SETUP_OVERUNDERRUN_CALLBACK_t callback);
 
+/**
+ * @ingroup usb_peripheral
+ * @brief Sets the callback for the end of the OUT data stage, called before the status stage is sent.
+ * @param callback - The function to call once all data of a control write has been received, or NULL
+ * @return None.
+ */
+void USB_ControlDataReceivedCallbackRegister(USB_SETUP_DATA_RECEIVED_CALLBACK_t callback);
+
 /**
  * @ingroup usb_peripheral
  * @brief Handles the control Over/Underflow events.
@@ -325,6 +334,14 @@ RETURN_CODE_t USB_HandleEventStalled(USB_PIPE_t pipe);
  */
 void USB_PeripheralInitialize(void);
 
+/**
+ * @ingroup usb_peripheral
+ * @brief Clears the device address, the FIFO and the endpoint table after a bus reset without disabling the peripheral.
+ * @param None.
+ * @return None.
+ */
+void USB_PeripheralBusReset(void);
+
 /**
  * @ingroup usb_peripheral
  * @brief Disables the USB peripheral and aborts any ongoing transaction.
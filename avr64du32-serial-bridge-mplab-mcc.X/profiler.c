@@ -0,0 +1,146 @@
+#include "profiler.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if PROFILER_ENABLE
+
+//Time source, a host build defines both to run the profiler without the timer
+#ifndef PROFILER_NOW
+#include "timebase.h"
+#define PROFILER_NOW() Timebase_GetCycles()
+#define PROFILER_TICKS_PER_US TIMEBASE_TICKS_PER_US
+#endif
+
+typedef struct {
+    uint16_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+    uint16_t buckets[PROFILER_BUCKETS];
+} profiler_stats_t;
+
+static profiler_stats_t stats[PROFILER_SECTIONS];
+
+//Adds 1 to COUNTER, stops at the maximum
+static void Profiler_Increment(uint16_t* counter)
+{
+    if (*counter != UINT16_MAX)
+    {
+        (*counter)++;
+    }
+}
+
+//Converts TICKS to us, stops at the maximum of 16 bits
+static uint16_t Profiler_ToMicros(uint32_t ticks)
+{
+    uint32_t us = ticks / PROFILER_TICKS_PER_US;
+    
+    return (us > UINT16_MAX) ? UINT16_MAX : (uint16_t) us;
+}
+
+//Returns the histogram bucket of a run of TICKS
+static uint8_t Profiler_GetBucket(uint32_t ticks)
+{
+    uint8_t bucket = 0;
+    
+    //Position of the highest set bit, less the shift
+    ticks >>= (PROFILER_BUCKET_SHIFT + 1);
+    while ((ticks != 0) && (bucket < (PROFILER_BUCKETS - 1)))
+    {
+        ticks >>= 1;
+        bucket++;
+    }
+    
+    return bucket;
+}
+
+//Clears the statistics of all sections
+void Profiler_Initialize(void)
+{
+    for (uint8_t i = 0; i < PROFILER_SECTIONS; i++)
+    {
+        Profiler_Reset((profiler_section_t) i);
+    }
+}
+
+//Returns the current time in ticks, for PROFILER_START
+uint32_t Profiler_Now(void)
+{
+    return PROFILER_NOW();
+}
+
+//Adds the run of SECTION that started at START (from Profiler_Now)
+void Profiler_Record(profiler_section_t section, uint32_t start)
+{
+    //Unsigned math handles the wrap-around
+    uint32_t ticks = PROFILER_NOW() - start;
+    profiler_stats_t* entry = &stats[section];
+    
+    entry->min = (ticks < entry->min) ? ticks : entry->min;
+    entry->max = (ticks > entry->max) ? ticks : entry->max;
+    Profiler_Increment(&entry->buckets[Profiler_GetBucket(ticks)]);
+    
+    //Once the count or the sum is full, the average stays the one of the runs counted so far
+    if ((entry->count != UINT16_MAX) && (entry->sum <= (UINT32_MAX - ticks)))
+    {
+        entry->count++;
+        entry->sum += ticks;
+    }
+}
+
+//Returns the count, min, avg and max of SECTION, false if SECTION is invalid
+bool Profiler_GetSummary(profiler_section_t section, profiler_summary_t* summary)
+{
+    profiler_stats_t* entry;
+    
+    if (section >= PROFILER_SECTIONS)
+    {
+        return false;
+    }
+    
+    entry = &stats[section];
+    summary->count = entry->count;
+    summary->min = (entry->count == 0) ? 0 : Profiler_ToMicros(entry->min);
+    summary->avg = (entry->count == 0) ? 0 : Profiler_ToMicros(entry->sum / entry->count);
+    summary->max = Profiler_ToMicros(entry->max);
+    return true;
+}
+
+//Copies the PROFILER_BUCKETS histogram counts of SECTION to BUCKETS, false if SECTION is invalid
+bool Profiler_GetHistogram(profiler_section_t section, uint16_t* buckets)
+{
+    if (section >= PROFILER_SECTIONS)
+    {
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < PROFILER_BUCKETS; i++)
+    {
+        buckets[i] = stats[section].buckets[i];
+    }
+    return true;
+}
+
+//Clears the statistics of SECTION
+void Profiler_Reset(profiler_section_t section)
+{
+    profiler_stats_t* entry;
+    
+    if (section >= PROFILER_SECTIONS)
+    {
+        return;
+    }
+    
+    entry = &stats[section];
+    entry->count = 0;
+    entry->min = UINT32_MAX;
+    entry->max = 0;
+    entry->sum = 0;
+    for (uint8_t i = 0; i < PROFILER_BUCKETS; i++)
+    {
+        entry->buckets[i] = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef PROFILER_H
+#define	PROFILER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Set to 0 to compile the profiler out, the PROFILER_START/STOP macros then expand to nothing
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE 1
+#endif
+
+//Histogram buckets, bucket N counts runs of 2^(N + PROFILER_BUCKET_SHIFT) to 2^(N + PROFILER_BUCKET_SHIFT + 1) - 1 ticks
+//Bucket 0 also counts shorter runs, the last bucket also counts longer runs
+#define PROFILER_BUCKETS 16
+#define PROFILER_BUCKET_SHIFT 6
+
+    //Code paths that are timed
+    typedef enum {
+        PROFILER_TASK = 0,      //Each scheduler task run, the busy time of one pass of the main loop
+        PROFILER_USB_TASK,      //Main_USBTask, the stack and all USB interfaces
+        PROFILER_USB_DEVICE,    //USBDevice_Handle
+        PROFILER_TEXT_PARSER,   //TextParser_Handle
+        PROFILER_I2C,           //One I2C transaction, from the start to the stop condition
+        PROFILER_SPI,           //One SPI exchange, chip select included
+        PROFILER_SECTIONS
+    } profiler_section_t;
+
+    typedef struct {
+        uint16_t count;     //Runs in the average (saturating)
+        uint16_t min;       //Shortest run in us
+        uint16_t avg;       //Average run in us
+        uint16_t max;       //Longest run in us (saturating)
+    } profiler_summary_t;
+
+#if PROFILER_ENABLE
+//Times the code from PROFILER_START to PROFILER_STOP of the same SECTION, in the same block
+#define PROFILER_START(section) uint32_t profilerStart_##section = Profiler_Now()
+#define PROFILER_STOP(section) Profiler_Record(section, profilerStart_##section)
+#else
+#define PROFILER_START(section)
+#define PROFILER_STOP(section)
+#endif
+
+    //Clears the statistics of all sections
+    void Profiler_Initialize(void);
+
+    //Returns the current time in ticks, for PROFILER_START
+    uint32_t Profiler_Now(void);
+
+    //Adds the run of SECTION that started at START (from Profiler_Now)
+    void Profiler_Record(profiler_section_t section, uint32_t start);
+
+    //Returns the count, min, avg and max of SECTION, false if SECTION is invalid
+    bool Profiler_GetSummary(profiler_section_t section, profiler_summary_t* summary);
+
+    //Copies the PROFILER_BUCKETS histogram counts of SECTION to BUCKETS, false if SECTION is invalid
+    bool Profiler_GetHistogram(profiler_section_t section, uint16_t* buckets);
+
+    //Clears the statistics of SECTION
+    void Profiler_Reset(profiler_section_t section);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PROFILER_H */
+
@@ -0,0 +1,97 @@
+#include "scheduler.h"
+
+#include <xc.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+#include "profiler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint8_t events;
+    scheduler_task_t task;
+} scheduler_entry_t;
+
+static scheduler_entry_t tasks[SCHEDULER_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+//Events at least one task waits on, others are ignored so they can't keep the core awake
+static uint8_t waitedEvents = 0;
+
+//Events posted but not yet handed to a task
+static volatile uint8_t pending = 0;
+
+//Removes all tasks and pending events
+void Scheduler_Initialize(void)
+{
+    taskCount = 0;
+    waitedEvents = 0;
+    pending = 0;
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+//Adds TASK, run when any of EVENTS is posted
+bool Scheduler_AddTask(uint8_t events, scheduler_task_t task)
+{
+    if ((taskCount >= SCHEDULER_MAX_TASKS) || (task == NULL))
+    {
+        return false;
+    }
+
+    tasks[taskCount].events = events;
+    tasks[taskCount].task = task;
+    taskCount++;
+    waitedEvents |= events;
+
+    return true;
+}
+
+//Marks EVENTS as pending, can be called from interrupts
+void Scheduler_Post(uint8_t events)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        pending |= (events & waitedEvents);
+    }
+}
+
+//Runs the highest priority task with a pending event to completion
+void Scheduler_Handle(void)
+{
+    uint8_t events;
+
+    for (uint8_t i = 0; i < taskCount; i++)
+    {
+        //Take the events of this task
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            events = pending & tasks[i].events;
+            pending &= ~events;
+        }
+
+        if (events != 0)
+        {
+            PROFILER_START(PROFILER_TASK);
+            tasks[i].task(events);
+            PROFILER_STOP(PROFILER_TASK);
+
+            //Start over, a higher priority task may have work now
+            return;
+        }
+    }
+
+    //Nothing to do, an interrupt posting between the check and the sleep still wakes the core
+    cli();
+    if (pending == 0)
+    {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+}
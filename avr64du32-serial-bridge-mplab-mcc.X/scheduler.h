@@ -0,0 +1,46 @@
+#ifndef SCHEDULER_H
+#define	SCHEDULER_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Number of tasks that can be added
+#define SCHEDULER_MAX_TASKS 4
+
+//Events, posted from interrupts or by other tasks
+#define SCHEDULER_EVENT_USB 0x01        //USB interrupt (setup, transfer complete or bus event)
+#define SCHEDULER_EVENT_USB_TX 0x02     //Data is waiting in the CDC buffers
+#define SCHEDULER_EVENT_VBUS 0x04       //AC0 edge on VBUS
+#define SCHEDULER_EVENT_TICK 0x08       //1 ms tick (TCB0)
+#define SCHEDULER_EVENT_RX 0x10         //The USB stack has run, new data or line state may be waiting
+#define SCHEDULER_EVENT_UART 0x20       //The USART bridge has data to move
+#define SCHEDULER_EVENT_SOF 0x40        //Start-of-Frame, taken by the USB bus event interrupt
+
+    //Called with the pending events the task waits on
+    typedef void (*scheduler_task_t)(uint8_t events);
+
+    //Removes all tasks and pending events
+    void Scheduler_Initialize(void);
+
+    //Adds TASK, run when any of EVENTS is posted
+    //Tasks added first have the highest priority, each event goes to the first task that waits on it
+    //Returns false if the task table is full
+    bool Scheduler_AddTask(uint8_t events, scheduler_task_t task);
+
+    //Marks EVENTS as pending, can be called from interrupts
+    void Scheduler_Post(uint8_t events);
+
+    //Runs the highest priority task with a pending event to completion
+    //If no event is pending, the core sleeps (IDLE) until the next interrupt
+    void Scheduler_Handle(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SCHEDULER_H */
+
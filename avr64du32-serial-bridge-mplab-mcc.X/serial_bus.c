@@ -0,0 +1,572 @@
+#include "serial_bus.h"
+
+#include <xc.h>
+#include <util/delay.h>
+#include "mcc_generated_files/system/system.h"
+#include "profiler.h"
+#include "stats.h"
+#include "trace.h"
+#include "timebase.h"
+#include "usb_timestamp.h"
+#include "vbus.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+//TWI0 pins (PORTMUX default route)
+#define SERIAL_BUS_SDA_bm PIN2_bm
+#define SERIAL_BUS_SCL_bm PIN3_bm
+
+//Half of one SCL period during bus recovery (100 kHz)
+#define SERIAL_BUS_RECOVERY_HALF_PERIOD_US 5
+
+//State of the TWI0 driver, reset when a transfer is abandoned
+extern volatile i2c_event_status_t twi0_Status;
+
+//Time the last transaction completed
+static usb_timestamp_t lastStamp = {0, 0};
+
+//Set while an address NACK is an expected answer (scan, poll, ACK polling), it is then not counted
+static bool addrNackExpected = false;
+
+//Poll in progress, advanced one read at a time by SerialBus_PollStep
+static struct {
+    bool active;
+    bool isSPI;
+    uint8_t addr;
+    spi_target_t target;
+    uint8_t cmd[SERIAL_BUS_MAX_POLL_LENGTH];
+    uint8_t len;
+    uint8_t mask;
+    uint8_t expected;
+    uint16_t timeout;
+    uint32_t start;
+    uint8_t value;
+    uint16_t iterations;
+} poll;
+
+//Stamps the end of a transaction, returns STATUS
+static bus_status_t SerialBus_Completed(bus_status_t status)
+{
+    USBTimestamp_Get(&lastStamp);
+    return status;
+}
+
+//Applies the I2C bus settings to TWI0, call after SYSTEM_Initialize
+void SerialBus_Initialize(void)
+{
+    //The timeout can only be changed while the host is disabled
+    TWI0.MCTRLA &= ~TWI_ENABLE_bm;
+    TWI0.MCTRLA = (TWI0.MCTRLA & ~TWI_TIMEOUT_gm) | SERIAL_BUS_I2C_INACTIVE_TIMEOUT;
+    TWI0.MCTRLA |= TWI_ENABLE_bm;
+    TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+    
+    //The driver computes the baud rate for a 20 MHz clock
+    SerialBus_I2CSetSpeed(SERIAL_BUS_I2C_STANDARD_SPEED);
+}
+
+//Clocks SCL until the client releases SDA (up to 9 clocks), then sends a STOP
+//Returns true if both lines are released
+static bool SerialBus_I2CBusRecover(void)
+{
+    bool released;
+    
+    //Release both lines, then take the pins from the TWI
+    PORTA.OUTCLR = (SERIAL_BUS_SDA_bm | SERIAL_BUS_SCL_bm);
+    PORTA.DIRCLR = (SERIAL_BUS_SDA_bm | SERIAL_BUS_SCL_bm);
+    TWI0.MCTRLA &= ~TWI_ENABLE_bm;
+    
+    for (uint8_t clocks = 0; (clocks < 9) && (!(VPORTA.IN & SERIAL_BUS_SDA_bm)); clocks++)
+    {
+        PORTA.DIRSET = SERIAL_BUS_SCL_bm;
+        _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+        PORTA.DIRCLR = SERIAL_BUS_SCL_bm;
+        _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+    }
+    
+    //STOP condition: SDA rises while SCL is high
+    PORTA.DIRSET = SERIAL_BUS_SCL_bm;
+    _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+    PORTA.DIRSET = SERIAL_BUS_SDA_bm;
+    _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+    PORTA.DIRCLR = SERIAL_BUS_SCL_bm;
+    _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+    PORTA.DIRCLR = SERIAL_BUS_SDA_bm;
+    _delay_us(SERIAL_BUS_RECOVERY_HALF_PERIOD_US);
+    
+    released = ((VPORTA.IN & SERIAL_BUS_SDA_bm) && (VPORTA.IN & SERIAL_BUS_SCL_bm));
+    
+    //Give the pins back to the TWI and clear the flags of the abandoned transfer
+    TWI0.MCTRLA |= TWI_ENABLE_bm;
+    PORTA.DIRSET = (SERIAL_BUS_SDA_bm | SERIAL_BUS_SCL_bm);
+    TWI0.MSTATUS = (TWI_RIF_bm | TWI_WIF_bm | TWI_RXACK_bm | TWI_ARBLOST_bm | TWI_BUSERR_bm | TWI_BUSSTATE_IDLE_gc);
+    
+    //Put the driver back to idle, as its reset event does
+    twi0_Status.busy = false;
+    twi0_Status.state = I2C_STATE_IDLE;
+    twi0_Status.errorState = I2C_ERROR_NONE;
+    
+    return released;
+}
+
+//Frees the bus after a missed deadline
+static bus_status_t SerialBus_I2CRecover(void)
+{
+    Stats_Increment(STATS_I2C_TIMEOUT);
+    return (SerialBus_I2CBusRecover()) ? BUS_TIMEOUT : BUS_STUCK;
+}
+
+//Runs the I2C state machine until the bus is idle, or the deadline from START passes
+static bus_status_t SerialBus_I2CWait(uint32_t start)
+{
+    while (I2C0_Host_IsBusy())
+    {
+        I2C0_Host_Tasks();
+        
+        if (Timebase_HasElapsed(start, SERIAL_BUS_I2C_DEADLINE_MS))
+        {
+            return SerialBus_I2CRecover();
+        }
+    }
+
+    //The error is cleared once read, so each one is counted once
+    switch (I2C0_Host_ErrorGet())
+    {
+        case I2C_ERROR_NONE:
+        {
+            return BUS_OK;
+        }
+        case I2C_ERROR_ADDR_NACK:
+        {
+            if (!addrNackExpected)
+            {
+                Stats_Increment(STATS_I2C_ADDR_NACK);
+            }
+            return BUS_ADDR_NACK;
+        }
+        case I2C_ERROR_DATA_NACK:
+        {
+            Stats_Increment(STATS_I2C_DATA_NACK);
+            return BUS_DATA_NACK;
+        }
+        case I2C_ERROR_BUS_COLLISION:
+        {
+            Stats_Increment(STATS_I2C_BUS_COLLISION);
+            return BUS_COLLISION;
+        }
+        default:
+        {
+            return BUS_ERROR;
+        }
+    }
+}
+
+//Writes LEN bytes to the I2C client at ADDR and waits for completion
+//A LEN of 0 performs an address-only transaction
+bus_status_t SerialBus_I2CWrite(uint8_t addr, uint8_t* data, uint8_t len)
+{
+    uint32_t start = Timebase_GetMillis();
+    bus_status_t status;
+    
+    //Wait for an idle bus
+    status = SerialBus_I2CWait(start);
+    if (status != BUS_OK)
+    {
+        return status;
+    }
+    
+    PROFILER_START(PROFILER_I2C);
+    TRACE_EVENT(TRACE_I2C_START, addr << 1);
+    I2C0_Host_Write(addr, data, len);
+    status = SerialBus_I2CWait(start);
+    TRACE_EVENT(TRACE_I2C_END, status);
+    PROFILER_STOP(PROFILER_I2C);
+    return SerialBus_Completed(status);
+}
+
+//Reads LEN bytes from the I2C client at ADDR and waits for completion
+bus_status_t SerialBus_I2CRead(uint8_t addr, uint8_t* data, uint8_t len)
+{
+    uint32_t start = Timebase_GetMillis();
+    bus_status_t status;
+    
+    //Wait for an idle bus
+    status = SerialBus_I2CWait(start);
+    if (status != BUS_OK)
+    {
+        return status;
+    }
+    
+    PROFILER_START(PROFILER_I2C);
+    TRACE_EVENT(TRACE_I2C_START, (addr << 1) | 0x01);
+    I2C0_Host_Read(addr, data, len);
+    status = SerialBus_I2CWait(start);
+    TRACE_EVENT(TRACE_I2C_END, status);
+    PROFILER_STOP(PROFILER_I2C);
+    return SerialBus_Completed(status);
+}
+
+//Writes WLEN bytes, restarts, then reads RLEN bytes from the I2C client at ADDR
+bus_status_t SerialBus_I2CWriteRead(uint8_t addr, uint8_t* wData, uint8_t wLen, uint8_t* rData, uint8_t rLen)
+{
+    uint32_t start = Timebase_GetMillis();
+    bus_status_t status;
+    
+    //Wait for an idle bus
+    status = SerialBus_I2CWait(start);
+    if (status != BUS_OK)
+    {
+        return status;
+    }
+    
+    PROFILER_START(PROFILER_I2C);
+    TRACE_EVENT(TRACE_I2C_START, addr << 1);
+    I2C0_Host_WriteRead(addr, wData, wLen, rData, rLen);
+    status = SerialBus_I2CWait(start);
+    TRACE_EVENT(TRACE_I2C_END, status);
+    PROFILER_STOP(PROFILER_I2C);
+    return SerialBus_Completed(status);
+}
+
+//Set while the caller probes for a client that may NACK its address, those NACKs are then not counted
+void SerialBus_I2CExpectAddrNack(bool expected)
+{
+    addrNackExpected = expected;
+}
+
+//Returns true if the I2C client at ADDR acknowledges its address
+bool SerialBus_I2CProbe(uint8_t addr)
+{
+    return (SerialBus_I2CWrite(addr, NULL, 0) == BUS_OK);
+}
+
+//Sets the I2C clock speed in Hz
+bool SerialBus_I2CSetSpeed(uint32_t speed)
+{
+    int32_t baud;
+    
+    if ((speed == 0) || (I2C0_Host_IsBusy()))
+    {
+        return false;
+    }
+    
+    //BAUD = (fCLK / fSCL - 10 - fCLK * tRISE) / 2, with tRISE = 100 ns
+    baud = ((int32_t) (F_CPU / speed) - 10 - (int32_t) (F_CPU / 10000000UL)) / 2;
+    
+    if ((baud < 0) || (baud > UINT8_MAX))
+    {
+        return false;
+    }
+    
+    //The baud rate can only be changed while the host is disabled
+    TWI0.MCTRLA &= ~TWI_ENABLE_bm;
+    
+    //Fast-mode Plus drive strength above 400 kHz
+    if (speed > SERIAL_BUS_I2C_FAST_SPEED)
+    {
+        TWI0.CTRLA |= TWI_FMPEN_bm;
+    }
+    else
+    {
+        TWI0.CTRLA &= ~TWI_FMPEN_bm;
+    }
+    
+    TWI0.MBAUD = (uint8_t) baud;
+    TWI0.MCTRLA |= TWI_ENABLE_bm;
+    TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+    
+    return true;
+}
+
+//Probes every valid 7-bit address, bit (ADDR % 8) of BITMAP[ADDR / 8] is set if the client responded
+bus_status_t SerialBus_I2CScan(uint8_t* bitmap, bool fast)
+{
+    bus_status_t status = BUS_OK;
+    
+    for (uint8_t i = 0; i < SERIAL_BUS_I2C_SCAN_SIZE; i++)
+    {
+        bitmap[i] = 0x00;
+    }
+    
+    if (fast)
+    {
+        SerialBus_I2CSetSpeed(SERIAL_BUS_I2C_FAST_SPEED);
+    }
+    
+    //Empty addresses are the expected answer, not errors
+    SerialBus_I2CExpectAddrNack(true);
+    
+    for (uint8_t addr = SERIAL_BUS_I2C_SCAN_FIRST; addr <= SERIAL_BUS_I2C_SCAN_LAST; addr++)
+    {
+        //Address-only write
+        status = SerialBus_I2CWrite(addr, NULL, 0);
+        
+        if (status == BUS_OK)
+        {
+            bitmap[addr >> 3] |= (1 << (addr & 0x07));
+        }
+        else if (status == BUS_ADDR_NACK)
+        {
+            //Nothing at this address
+            status = BUS_OK;
+        }
+        else
+        {
+            //Bus problem, stop scanning
+            break;
+        }
+    }
+    
+    SerialBus_I2CExpectAddrNack(false);
+    
+    if (fast)
+    {
+        SerialBus_I2CSetSpeed(SERIAL_BUS_I2C_STANDARD_SPEED);
+    }
+    
+    return status;
+}
+
+//Drives the chip select of the SPI TARGET
+static void SerialBus_SPISelect(spi_target_t target, bool select)
+{
+    switch (target)
+    {
+        case SPI_TARGET_EEPROM:
+        {
+            if (select)
+            {
+                EEPROM_CS_SetLow();
+            }
+            else
+            {
+                EEPROM_CS_SetHigh();
+            }
+            break;
+        }
+        case SPI_TARGET_DAC:
+        {
+            if (select)
+            {
+                DAC_CS_SetLow();
+            }
+            else
+            {
+                DAC_CS_SetHigh();
+            }
+            break;
+        }
+        case SPI_TARGET_USD:
+        {
+            if (select)
+            {
+                uSD_CS_SetLow();
+            }
+            else
+            {
+                uSD_CS_SetHigh();
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+}
+
+//Exchanges LEN bytes with the SPI TARGET, received bytes replace DATA
+void SerialBus_SPIExchange(spi_target_t target, uint8_t* data, uint8_t len)
+{
+    uint32_t start;
+    PROFILER_START(PROFILER_SPI);
+    TRACE_EVENT(TRACE_SPI_START, target);
+    
+    SerialBus_SPISelect(target, true);
+    start = Timebase_GetMicros();
+    
+    //Chip select setup time, one more microsecond as START is truncated
+    while (!Timebase_HasElapsedMicros(start, SERIAL_BUS_SPI_CS_SETUP_US + 1))
+    {
+        ;
+    }
+    
+    SPI0_Host_BufferExchange(data, len);
+    SerialBus_SPISelect(target, false);
+    TRACE_EVENT(TRACE_SPI_END, len);
+    PROFILER_STOP(PROFILER_SPI);
+    SerialBus_Completed(BUS_OK);
+}
+
+//Returns the time the last transaction completed
+void SerialBus_GetTimestamp(usb_timestamp_t* stamp)
+{
+    *stamp = lastStamp;
+}
+
+//Reads register REG of the I2C client at ADDR, replaces the bits in MASK with VALUE and writes it back
+bus_status_t SerialBus_I2CUpdate(uint8_t addr, uint8_t reg, uint8_t mask, uint8_t value, 
+        uint8_t* oldValue, uint8_t* newValue)
+{
+    uint8_t data[2];
+    bus_status_t status;
+    
+    //Read the current value
+    status = SerialBus_I2CWriteRead(addr, &reg, 1, oldValue, 1);
+    if (status != BUS_OK)
+    {
+        return status;
+    }
+    
+    *newValue = (*oldValue & ~mask) | (value & mask);
+    
+    //Write back the new value
+    data[0] = reg;
+    data[1] = *newValue;
+    return SerialBus_I2CWrite(addr, data, 2);
+}
+
+//Reads a register from the SPI TARGET, replaces the bits in MASK with VALUE and writes it back
+bus_status_t SerialBus_SPIUpdate(spi_target_t target, uint8_t readCmd, uint8_t writeCmd, uint8_t mask, uint8_t value, 
+        uint8_t* oldValue, uint8_t* newValue)
+{
+    uint8_t data[2];
+    
+    //Read the current value
+    data[0] = readCmd;
+    data[1] = 0x00;
+    SerialBus_SPIExchange(target, data, 2);
+    
+    *oldValue = data[1];
+    *newValue = (*oldValue & ~mask) | (value & mask);
+    
+    //Write back the new value
+    data[0] = writeCmd;
+    data[1] = *newValue;
+    SerialBus_SPIExchange(target, data, 2);
+    
+    return BUS_OK;
+}
+
+//Arms the poll set up by the caller
+static void SerialBus_PollStart(uint8_t mask, uint8_t expected, uint16_t timeout)
+{
+    poll.mask = mask;
+    poll.expected = expected;
+    poll.timeout = timeout;
+    poll.start = Timebase_GetMillis();
+    poll.value = 0x00;
+    poll.iterations = 0;
+    poll.active = true;
+}
+
+//Starts reading register REG of the I2C client at ADDR until (value & MASK) == EXPECTED or TIMEOUT ms pass
+bus_status_t SerialBus_I2CPollStart(uint8_t addr, uint8_t reg, uint8_t mask, uint8_t expected, uint16_t timeout)
+{
+    if (poll.active)
+    {
+        return BUS_ERROR;
+    }
+    
+    poll.isSPI = false;
+    poll.addr = addr;
+    poll.cmd[0] = reg;
+    poll.len = 1;
+    SerialBus_PollStart(mask, expected, timeout);
+    
+    return BUS_OK;
+}
+
+//Starts exchanging CMD with the SPI TARGET until (last byte & MASK) == EXPECTED or TIMEOUT ms pass
+bus_status_t SerialBus_SPIPollStart(spi_target_t target, uint8_t* cmd, uint8_t len, uint8_t mask, uint8_t expected, 
+        uint16_t timeout)
+{
+    if ((poll.active) || (len == 0) || (len > SERIAL_BUS_MAX_POLL_LENGTH))
+    {
+        return BUS_ERROR;
+    }
+    
+    poll.isSPI = true;
+    poll.target = target;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        poll.cmd[i] = cmd[i];
+    }
+    poll.len = len;
+    SerialBus_PollStart(mask, expected, timeout);
+    
+    return BUS_OK;
+}
+
+//Runs one read of the poll, returns BUS_BUSY while the poll goes on
+bus_status_t SerialBus_PollStep(uint8_t* value, uint16_t* iterations)
+{
+    bus_status_t status;
+    
+    if (!poll.active)
+    {
+        return BUS_ERROR;
+    }
+    
+    if (poll.isSPI)
+    {
+        uint8_t data[SERIAL_BUS_MAX_POLL_LENGTH];
+        
+        //Exchange overwrites the buffer, so reload the command each time
+        for (uint8_t i = 0; i < poll.len; i++)
+        {
+            data[i] = poll.cmd[i];
+        }
+        
+        SerialBus_SPIExchange(poll.target, data, poll.len);
+        poll.value = data[poll.len - 1];
+        status = BUS_OK;
+    }
+    else
+    {
+        //A busy device may NACK its address until it is ready
+        SerialBus_I2CExpectAddrNack(true);
+        status = SerialBus_I2CWriteRead(poll.addr, poll.cmd, 1, &poll.value, 1);
+        SerialBus_I2CExpectAddrNack(false);
+    }
+    
+    if (poll.iterations != UINT16_MAX)
+    {
+        poll.iterations++;
+    }
+    
+    *value = poll.value;
+    *iterations = poll.iterations;
+    
+    if (status == BUS_OK)
+    {
+        if ((poll.value & poll.mask) == poll.expected)
+        {
+            poll.active = false;
+            return BUS_OK;
+        }
+    }
+    else if (status != BUS_ADDR_NACK)
+    {
+        //A busy device may NACK its address, anything else ends the poll
+        poll.active = false;
+        return status;
+    }
+    
+    if (!VBUS_IsPresent())
+    {
+        //The host is gone, nobody is waiting for the result
+        poll.active = false;
+        return BUS_NOT_READY;
+    }
+    
+    if (Timebase_HasElapsed(poll.start, poll.timeout))
+    {
+        //Report the NACK if the device never answered
+        poll.active = false;
+        return (status == BUS_OK) ? BUS_NOT_READY : status;
+    }
+    
+    return BUS_BUSY;
+}
@@ -0,0 +1,110 @@
+#ifndef SERIAL_BUS_H
+#define	SERIAL_BUS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usb_timestamp.h"
+
+    typedef enum {
+        BUS_OK = 0, BUS_ADDR_NACK, BUS_DATA_NACK, BUS_ERROR, BUS_NOT_READY, BUS_COLLISION, BUS_TIMEOUT, BUS_STUCK, BUS_BUSY
+    } bus_status_t;
+
+    typedef enum {
+        SPI_TARGET_EEPROM = 0, SPI_TARGET_DAC, SPI_TARGET_USD
+    } spi_target_t;
+
+//Time allowed for one I2C transaction (including waiting for an idle bus) before the bus is recovered
+#define SERIAL_BUS_I2C_DEADLINE_MS 25
+
+//TWI bus inactivity timeout, TWI_TIMEOUT_50US_gc, TWI_TIMEOUT_100US_gc, TWI_TIMEOUT_200US_gc or TWI_TIMEOUT_DISABLED_gc
+//The host treats the bus as idle once SCL has been high this long, so a missed STOP does not block it
+#define SERIAL_BUS_I2C_INACTIVE_TIMEOUT TWI_TIMEOUT_200US_gc
+
+//I2C clock speeds
+#define SERIAL_BUS_I2C_STANDARD_SPEED 100000UL
+#define SERIAL_BUS_I2C_FAST_SPEED 400000UL
+    
+//Addresses probed by a scan (reserved addresses are skipped)
+#define SERIAL_BUS_I2C_SCAN_FIRST 0x08
+#define SERIAL_BUS_I2C_SCAN_LAST 0x77
+    
+//Size of the scan bitmap, 1 bit per 7-bit address
+#define SERIAL_BUS_I2C_SCAN_SIZE 16
+
+//Time from chip select to the first SCK edge
+#define SERIAL_BUS_SPI_CS_SETUP_US 1
+
+//Largest SPI command that can be repeated by a poll
+#define SERIAL_BUS_MAX_POLL_LENGTH 8
+
+    //Applies the I2C bus settings to TWI0, call after SYSTEM_Initialize
+    void SerialBus_Initialize(void);
+
+    //I2C transactions that miss the deadline return BUS_TIMEOUT once the bus is recovered, 
+    //or BUS_STUCK if a client still holds the bus low
+    
+    //Writes LEN bytes to the I2C client at ADDR and waits for completion
+    //A LEN of 0 performs an address-only transaction
+    bus_status_t SerialBus_I2CWrite(uint8_t addr, uint8_t* data, uint8_t len);
+
+    //Reads LEN bytes from the I2C client at ADDR and waits for completion
+    bus_status_t SerialBus_I2CRead(uint8_t addr, uint8_t* data, uint8_t len);
+
+    //Writes WLEN bytes, restarts, then reads RLEN bytes from the I2C client at ADDR
+    bus_status_t SerialBus_I2CWriteRead(uint8_t addr, uint8_t* wData, uint8_t wLen, uint8_t* rData, uint8_t rLen);
+
+    //Set while the caller probes for a client that may NACK its address, those NACKs are then not counted
+    //The scan and the I2C poll set it themselves
+    void SerialBus_I2CExpectAddrNack(bool expected);
+
+    //Returns true if the I2C client at ADDR acknowledges its address
+    bool SerialBus_I2CProbe(uint8_t addr);
+
+    //Sets the I2C clock speed in Hz, speeds above 400 kHz use Fast-mode Plus drive strength
+    //Returns false while a transfer is running or if the speed is out of range
+    bool SerialBus_I2CSetSpeed(uint32_t speed);
+
+    //Probes every valid 7-bit address, bit (ADDR % 8) of BITMAP[ADDR / 8] is set if the client responded
+    //If FAST is set, the probe runs at 400 kHz instead of 100 kHz
+    bus_status_t SerialBus_I2CScan(uint8_t* bitmap, bool fast);
+
+    //Exchanges LEN bytes with the SPI TARGET, received bytes replace DATA
+    void SerialBus_SPIExchange(spi_target_t target, uint8_t* data, uint8_t len);
+
+    //Returns the time the last I2C or SPI transaction completed, including failed I2C transactions
+    void SerialBus_GetTimestamp(usb_timestamp_t* stamp);
+
+    //Reads register REG of the I2C client at ADDR, replaces the bits in MASK with VALUE and writes it back
+    //OLDVALUE and NEWVALUE hold the register before and after the update
+    bus_status_t SerialBus_I2CUpdate(uint8_t addr, uint8_t reg, uint8_t mask, uint8_t value, 
+            uint8_t* oldValue, uint8_t* newValue);
+
+    //Reads a register from the SPI TARGET with <READCMD> <00>, replaces the bits in MASK with VALUE 
+    //and writes it back with <WRITECMD> <NEW VALUE>
+    bus_status_t SerialBus_SPIUpdate(spi_target_t target, uint8_t readCmd, uint8_t writeCmd, uint8_t mask, uint8_t value, 
+            uint8_t* oldValue, uint8_t* newValue);
+
+    //Starts reading register REG of the I2C client at ADDR until (value & MASK) == EXPECTED or TIMEOUT ms pass
+    //Returns BUS_ERROR if a poll is already running
+    bus_status_t SerialBus_I2CPollStart(uint8_t addr, uint8_t reg, uint8_t mask, uint8_t expected, uint16_t timeout);
+
+    //Starts exchanging CMD with the SPI TARGET until (last byte & MASK) == EXPECTED or TIMEOUT ms pass
+    //Returns BUS_ERROR if a poll is already running or LEN is out of range
+    bus_status_t SerialBus_SPIPollStart(spi_target_t target, uint8_t* cmd, uint8_t len, uint8_t mask, uint8_t expected, 
+            uint16_t timeout);
+
+    //Runs one read or exchange of the poll, so the caller can return to the scheduler between reads
+    //Returns BUS_BUSY while the poll goes on, then BUS_OK on a match or BUS_NOT_READY on timeout
+    //VALUE and ITERATIONS hold the last value read and the number of reads
+    bus_status_t SerialBus_PollStep(uint8_t* value, uint16_t* iterations);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SERIAL_BUS_H */
+
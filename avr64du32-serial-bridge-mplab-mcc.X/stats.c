@@ -0,0 +1,96 @@
+#include "stats.h"
+
+#include <util/atomic.h>
+#include "usb_core.h"
+#include "usb_core_events.h"
+#include "usb_cdc_virtual_serial_port.h"
+#if USB_CDC_DATA_PORT_ENABLE
+#include "usb_cdc_data_port.h"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Counters kept by the application, the USB stack keeps its own
+static volatile uint32_t counters[STATS_COUNTERS];
+
+//Adds 1 to COUNTER, safe to use from interrupts, not for the USB counters
+void Stats_Increment(stats_counter_t counter)
+{
+    Stats_Add(counter, 1);
+}
+
+//Adds AMOUNT to COUNTER, safe to use from interrupts, not for the USB counters
+void Stats_Add(stats_counter_t counter, uint16_t amount)
+{
+    if (counter >= STATS_COUNTERS)
+    {
+        return;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        counters[counter] += amount;
+    }
+}
+
+//Returns the value of COUNTER, 0 if COUNTER is invalid
+uint32_t Stats_Get(stats_counter_t counter)
+{
+    uint32_t result = 0;
+
+    switch (counter)
+    {
+        case STATS_CDC_RX_DROPPED:
+        {
+            result = USB_CDCReceiveDroppedGet();
+            break;
+        }
+        case STATS_CDC_DATA_RX_DROPPED:
+        {
+#if USB_CDC_DATA_PORT_ENABLE
+            result = USB_CDCDataPortReceiveDroppedGet();
+#endif
+            break;
+        }
+        case STATS_USB_OVERUNDERFLOW:
+        {
+            result = USB_EventOverUnderflowCountGet();
+            break;
+        }
+        default:
+        {
+            if (counter < STATS_COUNTERS)
+            {
+                //32-bit value may be updated in an ISR
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                {
+                    result = counters[counter];
+                }
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+//Writes all STATS_COUNTERS counters to DATA, STATS_COUNTER_SIZE bytes each
+//If MSB_FIRST is cleared, each counter is written LSB first
+void Stats_Write(uint8_t* data, bool msbFirst)
+{
+    uint32_t value;
+
+    for (uint8_t i = 0; i < STATS_COUNTERS; i++)
+    {
+        value = Stats_Get((stats_counter_t) i);
+
+        for (uint8_t j = 0; j < STATS_COUNTER_SIZE; j++)
+        {
+            data[(msbFirst) ? (STATS_COUNTER_SIZE - 1 - j) : j] = (value & 0xFF);
+            value >>= 8;
+        }
+
+        data += STATS_COUNTER_SIZE;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef STATS_H
+#define	STATS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Bytes of each counter sent by the STATS command and the vendor request
+#define STATS_COUNTER_SIZE 4
+
+    //Error counters, the counters are never cleared and wrap around after 2^32
+    //The USB counters are kept by the USB stack and only read here
+    typedef enum {
+        STATS_CDC_RX_DROPPED = 0,       //Bytes received on the serial port that did not fit the receive buffer
+        STATS_CDC_DATA_RX_DROPPED,      //Bytes received on the data port that did not fit the receive buffer
+        STATS_TEXT_QUEUE_DROPPED,       //Response characters dropped by the text queue, full or discarded by the output policy
+        STATS_USB_OVERUNDERFLOW,        //Overflows and underflows on the endpoints other than the control endpoint
+        STATS_I2C_ADDR_NACK,            //Addresses not acknowledged by ordinary transactions, not by scans, polls or EEPROM ACK polling
+        STATS_I2C_DATA_NACK,            //Data bytes not acknowledged
+        STATS_I2C_BUS_COLLISION,        //Bus errors and lost arbitrations
+        STATS_I2C_TIMEOUT,              //Transactions that missed the deadline, the bus was then recovered
+        STATS_COUNTERS
+    } stats_counter_t;
+
+    //Adds 1 to COUNTER, safe to use from interrupts, not for the USB counters
+    void Stats_Increment(stats_counter_t counter);
+
+    //Adds AMOUNT to COUNTER, safe to use from interrupts, not for the USB counters
+    void Stats_Add(stats_counter_t counter, uint16_t amount);
+
+    //Returns the value of COUNTER, 0 if COUNTER is invalid
+    uint32_t Stats_Get(stats_counter_t counter);
+
+    //Writes all STATS_COUNTERS counters to DATA, STATS_COUNTER_SIZE bytes each
+    //If MSB_FIRST is cleared, each counter is written LSB first
+    void Stats_Write(uint8_t* data, bool msbFirst);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* STATS_H */
+
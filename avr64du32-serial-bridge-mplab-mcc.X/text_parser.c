@@ -4,24 +4,47 @@
 #include "mcc_generated_files/system/system.h"
 #include "mcc_generated_files/usb/usb_cdc/usb_cdc_virtual_serial_port.h"
 #include "text_queue.h"
-#include "mcc_generated_files/timer/delay.h"
+#include "serial_bus.h"
+#include "i2c_eeprom.h"
+#include "uart_bridge.h"
+#include "usb_recovery.h"
+#include "usb_timestamp.h"
+#include "profiler.h"
+#include "trace.h"
+#include "stats.h"
+#include "scheduler.h"
 
 #include <stdint.h>
 #include <stdbool.h>
 
 typedef enum {
-    COMMAND_OK = 0, COMMAND_INVALID, COMMAND_ADDR_NACK, COMMAND_DATA_NACK
+    COMMAND_OK = 0, COMMAND_INVALID, COMMAND_ADDR_NACK, COMMAND_DATA_NACK, COMMAND_NOT_READY, COMMAND_POLL_TIMEOUT, 
+    COMMAND_BUS_COLLISION, COMMAND_BUS_TIMEOUT, COMMAND_BUS_STUCK, COMMAND_UART_CONFIG
 } command_error_t;
 
 typedef enum {
-    SERIAL_UNKNOWN = 0, SERIAL_SPI_DAC, SERIAL_SPI_EEPROM, SERIAL_SPI_USD, SERIAL_I2C_READ, SERIAL_I2C_WRITE, SERIAL_I2C_WRITE_READ
+    SERIAL_UNKNOWN = 0, SERIAL_SPI, SERIAL_I2C_READ, SERIAL_I2C_WRITE, SERIAL_I2C_WRITE_READ, SERIAL_I2C_PROGRAM, SERIAL_POLL, SERIAL_UPDATE, SERIAL_I2C_SCAN, 
+    SERIAL_UART_BRIDGE, SERIAL_OUTPUT, SERIAL_USB_RECOVERY, SERIAL_TIME, SERIAL_PROFILER, SERIAL_TRACE, SERIAL_STATS
 } serial_type_t;
 
+typedef enum {
+    UPDATE_NONE = 0, UPDATE_SET, UPDATE_CLEAR, UPDATE_FIELD
+} update_type_t;
+
 //Text Buffer
 static char buffer[PARSER_BUFFER_SIZE];
 static uint8_t textLength = 0;
 static uint8_t readPos = 0;
 
+//Print the timestamp after each bus command
+static bool printTimestamp = false;
+
+//A POLL command is running, one read per call of TextParser_Handle
+static bool pollPending = false;
+
+//Trace events printed by each TRACE command, 30 bytes
+#define TRACE_ENTRIES_PER_LINE 5
+
 //Advances to the position after the next ' ' or EOF in the string
 bool AdvanceBuffer(void)
 {
@@ -164,7 +187,8 @@ bool ConvertStringToHex(uint8_t* dst)
     //For single-digit numbers (a, 4, etc...)
     if ((*ptr == ' ') || (*ptr == '\0'))
     {
-        return result;
+        *dst = result;
+        return true;
     }
     
     result <<= 4;
@@ -195,6 +219,12 @@ uint8_t ConvertTextToHexArray(uint8_t* dst, uint8_t maxLen)
     uint8_t len = 0;
     do
     {
+        //Out of space for more values
+        if (len == maxLen)
+        {
+            return 0;
+        }
+        
         //Convert the chunk to a hex number
         if (!ConvertStringToHex((dst + len)))
         {
@@ -210,9 +240,120 @@ uint8_t ConvertTextToHexArray(uint8_t* dst, uint8_t maxLen)
     return len;
 }
 
-void LoadDataToOutputQueue(uint8_t* data, uint8_t len)
+//Converts the result of a bus operation into a command status
+command_error_t GetCommandStatus(bus_status_t status)
 {
-    TextQueue_AddText("> ");
+    switch (status)
+    {
+        case BUS_OK:
+        {
+            return COMMAND_OK;
+        }
+        case BUS_ADDR_NACK:
+        {
+            return COMMAND_ADDR_NACK;
+        }
+        case BUS_DATA_NACK:
+        {
+            return COMMAND_DATA_NACK;
+        }
+        case BUS_NOT_READY:
+        {
+            return COMMAND_NOT_READY;
+        }
+        case BUS_COLLISION:
+        {
+            return COMMAND_BUS_COLLISION;
+        }
+        case BUS_TIMEOUT:
+        {
+            return COMMAND_BUS_TIMEOUT;
+        }
+        case BUS_STUCK:
+        {
+            return COMMAND_BUS_STUCK;
+        }
+        default:
+        {
+            return COMMAND_INVALID;
+        }
+    }
+}
+
+//Converts the current "chunk" of the sentence into an SPI target
+bool GetSPITarget(spi_target_t* target)
+{
+    if (StringMatch("EEPROM"))
+    {
+        *target = SPI_TARGET_EEPROM;
+    }
+    else if (StringMatch("DAC"))
+    {
+        *target = SPI_TARGET_DAC;
+    }
+    else if (StringMatch("USD"))
+    {
+        *target = SPI_TARGET_USD;
+    }
+    else
+    {
+        return false;
+    }
+    
+    return true;
+}
+
+//Checks to see if the current "chunk" of the sentence is a read-modify-write operation
+update_type_t GetUpdateType(void)
+{
+    if (StringMatch("SET"))
+    {
+        return UPDATE_SET;
+    }
+    else if (StringMatch("CLR"))
+    {
+        return UPDATE_CLEAR;
+    }
+    else if (StringMatch("UPD"))
+    {
+        return UPDATE_FIELD;
+    }
+    
+    return UPDATE_NONE;
+}
+
+//Gets the mask and value of a read-modify-write operation
+//SET and CLR take <BITS>, UPD takes <MASK> <VALUE>
+bool GetUpdateParameters(update_type_t type, uint8_t* params, uint8_t len, uint8_t* mask, uint8_t* value)
+{
+    if (type == UPDATE_FIELD)
+    {
+        if (len != 2)
+        {
+            return false;
+        }
+        
+        *mask = params[0];
+        *value = params[1];
+    }
+    else
+    {
+        if (len != 1)
+        {
+            return false;
+        }
+        
+        *mask = params[0];
+        *value = (type == UPDATE_SET) ? params[0] : 0x00;
+    }
+    
+    return true;
+}
+
+//Prints PREFIX, then DATA as hex bytes, then ends the line
+void LoadHexToOutputQueue(const char* prefix, uint8_t* data, uint8_t len)
+{
+    TextQueue_AddText(prefix);
     
     char buffer[4] = {'?', '?', ' ', '\0'};
     uint8_t temp;
@@ -253,6 +394,262 @@ void LoadDataToOutputQueue(uint8_t* data, uint8_t len)
     TextQueue_AddText("\r\n");
 }
 
+void LoadDataToOutputQueue(uint8_t* data, uint8_t len)
+{
+    LoadHexToOutputQueue("> ", data, len);
+}
+
+//Writes the time of the last bus transaction to DATA, frame then offset, MSB first
+void LoadTimestamp(uint8_t* data)
+{
+    usb_timestamp_t stamp;
+    
+    SerialBus_GetTimestamp(&stamp);
+    data[0] = (stamp.frame >> 8);
+    data[1] = (stamp.frame & 0xFF);
+    data[2] = (stamp.offset >> 8);
+    data[3] = (stamp.offset & 0xFF);
+}
+
+//Returns true for the commands that run a bus transaction, these are timestamped
+bool IsBusCommand(serial_type_t serialType)
+{
+    switch (serialType)
+    {
+        case SERIAL_SPI:
+        case SERIAL_I2C_READ:
+        case SERIAL_I2C_WRITE:
+        case SERIAL_I2C_WRITE_READ:
+        case SERIAL_I2C_PROGRAM:
+        case SERIAL_POLL:
+        case SERIAL_UPDATE:
+        case SERIAL_I2C_SCAN:
+        {
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+//Prints the result of a command, then signals its completion to the host
+void PrintCommandResult(serial_type_t serialType, command_error_t commandStatus, uint8_t* serialBytes, uint8_t len)
+{
+    switch (commandStatus)
+    {
+        case COMMAND_OK:
+        {
+            //Print results
+            switch (serialType)
+            {
+                case SERIAL_SPI:
+                {
+                    //SPI Communication
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_I2C_READ:
+                {
+                    //I2C Read
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_I2C_WRITE:
+                case SERIAL_I2C_PROGRAM:
+                {
+                    //I2C Write
+                    TextQueue_AddText("> OK\r\n");
+                    break;
+                }
+                case SERIAL_I2C_WRITE_READ:
+                {
+                    //I2C Write/Read
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_I2C_SCAN:
+                {
+                    //I2C Scan Bitmap
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_UPDATE:
+                {
+                    //Read-Modify-Write, old then new value
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_POLL:
+                {
+                    //Poll Result
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_UART_BRIDGE:
+                {
+                    //USART Bridge started
+                    TextQueue_AddText("> UART bridge\r\n");
+                    break;
+                }
+                case SERIAL_OUTPUT:
+                {
+                    //Dropped Characters
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_USB_RECOVERY:
+                {
+                    //Recovery Counters
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_TIME:
+                {
+                    //Frame and Offset
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_PROFILER:
+                {
+                    //Summary or Histogram, OK after a clear
+                    if (len == 0)
+                    {
+                        TextQueue_AddText("> OK\r\n");
+                    }
+                    else
+                    {
+                        LoadDataToOutputQueue(serialBytes, len);
+                    }
+                    break;
+                }
+                case SERIAL_TRACE:
+                {
+                    //Time, Event and Payload of each event, none once the ring is empty
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                case SERIAL_STATS:
+                {
+                    //Error Counters
+                    LoadDataToOutputQueue(serialBytes, len);
+                    break;
+                }
+                default:
+                {
+                    TextQueue_AddText("Unknown communication type\r\n");
+                }
+            }
+            break;
+        }
+        case COMMAND_INVALID:
+        {
+            TextQueue_AddText("Command parsing error\r\n");
+            break;
+        }
+        case COMMAND_ADDR_NACK:
+        {
+            TextQueue_AddText("I2C NACK error\r\n");
+            break;
+        }
+        case COMMAND_DATA_NACK:
+        {
+            TextQueue_AddText("I2C communication error\r\n");
+            break;
+        }
+        case COMMAND_NOT_READY:
+        {
+            TextQueue_AddText("I2C write cycle timeout\r\n");
+            break;
+        }
+        case COMMAND_BUS_COLLISION:
+        {
+            TextQueue_AddText("I2C bus collision\r\n");
+            break;
+        }
+        case COMMAND_BUS_TIMEOUT:
+        {
+            TextQueue_AddText("I2C bus timeout, bus recovered\r\n");
+            break;
+        }
+        case COMMAND_BUS_STUCK:
+        {
+            TextQueue_AddText("I2C bus stuck low\r\n");
+            break;
+        }
+        case COMMAND_UART_CONFIG:
+        {
+            TextQueue_AddText("UART line coding not supported\r\n");
+            break;
+        }
+        case COMMAND_POLL_TIMEOUT:
+        {
+            //Print the last value read
+            LoadDataToOutputQueue(serialBytes, len);
+            TextQueue_AddText("Poll timeout\r\n");
+            break;
+        }
+        default:
+        {
+            //Shouldn't get here
+            TextQueue_AddText("Unknown error\r\n");
+        }
+    }
+    
+    //Bus commands that ran a transaction, successful or not
+    if ((printTimestamp) && (IsBusCommand(serialType)) && (commandStatus != COMMAND_INVALID))
+    {
+        uint8_t stamp[USB_TIMESTAMP_SIZE];
+        
+        LoadTimestamp(stamp);
+        LoadHexToOutputQueue("@ ", stamp, USB_TIMESTAMP_SIZE);
+    }
+    
+    TRACE_EVENT(TRACE_COMMAND_END, commandStatus);
+    
+    //Signal command completion to the host (RI)
+    USB_CDCSerialStateEvent(USB_CDC_SERIAL_STATE_RING_SIGNAL_bm);
+    
+    //Clean-up
+    textLength = 0;
+}
+
+//Converts the result of a poll into a command status, DATA gets the final value and the iteration count
+command_error_t GetPollStatus(bus_status_t status, uint8_t value, uint16_t iterations, uint8_t* data)
+{
+    if ((status == BUS_OK) || (status == BUS_NOT_READY))
+    {
+        //Final value, then the iteration count (MSB first)
+        data[0] = value;
+        data[1] = (iterations >> 8);
+        data[2] = (iterations & 0xFF);
+        
+        return (status == BUS_OK) ? COMMAND_OK : COMMAND_POLL_TIMEOUT;
+    }
+    
+    return GetCommandStatus(status);
+}
+
+//Runs one read of the pending POLL, prints the result once it ends
+void HandlePoll(void)
+{
+    uint8_t data[3];
+    uint8_t value;
+    uint16_t iterations;
+    bus_status_t status = SerialBus_PollStep(&value, &iterations);
+    
+    if (status == BUS_BUSY)
+    {
+        //Come back on the next pass, the USB task runs in between
+        Scheduler_Post(SCHEDULER_EVENT_RX);
+        return;
+    }
+    
+    pollPending = false;
+    PrintCommandResult(SERIAL_POLL, GetPollStatus(status, value, iterations, data), data, 3);
+}
+
 //Initialize the text parser
 void TextParser_Initialize(void)
 {
@@ -270,6 +667,13 @@ void TextParser_Handle(void)
     char c;
     bool cmdReady = false;
     
+    //New commands wait in the CDC buffer until the poll ends
+    if (pollPending)
+    {
+        HandlePoll();
+        return;
+    }
+    
     //Load characters
     while (USB_CDCRead(&c) == CDC_SUCCESS)
     {
@@ -307,12 +711,45 @@ void TextParser_Handle(void)
     //Reset read position
     readPos = 0;
     
+#if TRACE_ENABLE
+    //A TRACE readout doesn't record itself, recording resumes once its result is printed
+    if (StringMatch("TRACE"))
+    {
+        Trace_Pause();
+    }
+#endif
+    TRACE_EVENT(TRACE_COMMAND_START, buffer[0]);
+    
     /* Commands:
      * SPI EEPROM <DATA>
      * SPI DAC <DATA>
+     * SPI <SPI TARGET> SET|CLR <READ CMD> <WRITE CMD> <BITS>
+     * SPI <SPI TARGET> UPD <READ CMD> <WRITE CMD> <MASK> <VALUE>
      * 
      * I2C W <ADDR> <DATA>
      * I2C RW <ADDR> <REG ADDR (1 Byte)> <LEN>
+     * I2C SCAN [FAST]
+     * I2C <ADDR> SET|CLR <REG ADDR> <BITS>
+     * I2C <ADDR> UPD <REG ADDR> <MASK> <VALUE>
+     * I2C <ADDR> PROG <PAGE SIZE> <ADDR LEN> <MEM ADDR> <DATA>
+     * 
+     * POLL I2C <ADDR> <REG ADDR> <MASK> <VALUE> <TIMEOUT>
+     * POLL <SPI TARGET> <MASK> <VALUE> <TIMEOUT> <DATA>
+     * 
+     * UART
+     * 
+     * OUTPUT [PARK|DROP|STREAM]
+     * 
+     * USB
+     * 
+     * TIME [ON|OFF]
+     * 
+     * PROF <SECTION> [HIST]
+     * PROF CLR
+     * 
+     * TRACE
+     * 
+     * STATS
      */
     
     command_error_t commandStatus = COMMAND_INVALID;
@@ -320,86 +757,105 @@ void TextParser_Handle(void)
     uint8_t serialBytes[MAX_SERIAL_PARAMETERS];
     uint8_t len;
     
-    if (StringContains("SPI"))
+    if (StringContains("POLL"))
     {
         if (AdvanceBuffer())
         {
-            //Advance to next parameter
-            if (StringMatch("EEPROM"))
+            spi_target_t target;
+            bus_status_t status = BUS_ERROR;
+            
+            serialType = SERIAL_POLL;
+            
+            if (StringMatch("I2C"))
             {
-                //Advance to next chunk
+                //I2C Register Poll
                 AdvanceBuffer();
                 
-                serialType = SERIAL_SPI_EEPROM;
-                
-                //Convert everything else to <data> parameters
+                //Get Address, Register, Mask, Value and Timeout
                 len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
-                if (len == 0)
+                
+                if (len == 5)
                 {
-                    //Nothing to convert, or conversion error
-                    commandStatus = COMMAND_INVALID;
-                }
-                else
-                {
-                    //Conversion Success
-                    EEPROM_CS_SetLow();
-                    DELAY_microseconds(1);
-                    SPI0_Host_BufferExchange(serialBytes, len);
-                    EEPROM_CS_SetHigh();
-                    
-                    commandStatus = COMMAND_OK;
+                    status = SerialBus_I2CPollStart(serialBytes[0], serialBytes[1], serialBytes[2], serialBytes[3], 
+                            serialBytes[4] * POLL_TIMEOUT_UNIT_MS);
                 }
             }
-            else if (StringMatch("DAC"))
+            else if (GetSPITarget(&target))
             {
-                //Advance to next chunk
+                //SPI Poll
                 AdvanceBuffer();
                 
-                serialType = SERIAL_SPI_DAC;
-                
-                //Convert everything else to <data> parameters
+                //Get Mask, Value, Timeout and the Bytes to Exchange
                 len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
-                if (len == 0)
-                {
-                    //Nothing to convert, or conversion error
-                    commandStatus = COMMAND_INVALID;
-                }
-                else
+                
+                if ((len > 3) && ((len - 3) <= SERIAL_BUS_MAX_POLL_LENGTH))
                 {
-                    //Conversion Success
-                    DAC_CS_SetLow();
-                    DELAY_microseconds(1);
-                    SPI0_Host_BufferExchange(serialBytes, len);
-                    DAC_CS_SetHigh();
-                    
-                    commandStatus = COMMAND_OK;
+                    status = SerialBus_SPIPollStart(target, &serialBytes[3], len - 3, serialBytes[0], serialBytes[1], 
+                            serialBytes[2] * POLL_TIMEOUT_UNIT_MS);
                 }
             }
-            else if (StringMatch("USD"))
+            
+            if (status == BUS_OK)
+            {
+                //The first read runs now, the result is printed once the poll ends
+                pollPending = true;
+                HandlePoll();
+                return;
+            }
+        }
+    }
+    else if (StringContains("SPI"))
+    {
+        if (AdvanceBuffer())
+        {
+            spi_target_t target;
+            update_type_t updateType;
+            uint8_t mask, value;
+            
+            //Advance to next parameter
+            if (GetSPITarget(&target))
             {
                 //Advance to next chunk
                 AdvanceBuffer();
                 
-                serialType = SERIAL_SPI_USD;
+                updateType = GetUpdateType();
                 
-                //Convert everything else to <data> parameters
-                len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
-                if (len == 0)
+                if (updateType != UPDATE_NONE)
                 {
-                    //Nothing to convert, or conversion error
-                    commandStatus = COMMAND_INVALID;
+                    //Read-Modify-Write
+                    AdvanceBuffer();
+                    
+                    serialType = SERIAL_UPDATE;
+                    
+                    //Get Read Command, Write Command, then the Mask / Value
+                    len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
+                    
+                    if ((len > 2) && (GetUpdateParameters(updateType, &serialBytes[2], len - 2, &mask, &value)))
+                    {
+                        commandStatus = GetCommandStatus(SerialBus_SPIUpdate(target, serialBytes[0], serialBytes[1], 
+                                mask, value, &serialBytes[0], &serialBytes[1]));
+                        len = 2;
+                    }
                 }
                 else
                 {
-                    //Conversion Success
-                    uSD_CS_SetLow();
-                    DELAY_microseconds(1);
-                    SPI0_Host_BufferExchange(serialBytes, len);
-                    uSD_CS_SetHigh();
+                    serialType = SERIAL_SPI;
+                
+                    //Convert everything else to <data> parameters
+                    len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
+                    if (len == 0)
+                    {
+                        //Nothing to convert, or conversion error
+                        commandStatus = COMMAND_INVALID;
+                    }
+                    else
+                    {
+                        //Conversion Success
+                        SerialBus_SPIExchange(target, serialBytes, len);
                     
-                    commandStatus = COMMAND_OK;
+                        commandStatus = COMMAND_OK;
+                    }
                 }
-
             }
         }
     }
@@ -409,12 +865,33 @@ void TextParser_Handle(void)
         {
             uint8_t addr;
             
+            if (StringMatch("SCAN"))
+            {
+                //Bus Scan
+                bool fast = false;
+                
+                serialType = SERIAL_I2C_SCAN;
+                
+                if (AdvanceBuffer())
+                {
+                    //Optional Fast-mode Probe
+                    fast = StringMatch("FAST");
+                }
+                
+                if ((fast) || (buffer[readPos] == '\0'))
+                {
+                    len = SERIAL_BUS_I2C_SCAN_SIZE;
+                    commandStatus = GetCommandStatus(SerialBus_I2CScan(serialBytes, fast));
+                }
+            }
             //Get the Address
-            if (ConvertStringToHex(&addr))
+            else if (ConvertStringToHex(&addr))
             {
                 //Address found
                 if (AdvanceBuffer())
                 {
+                    update_type_t updateType = GetUpdateType();
+                    
                     //Advance to type of operation
                     if (StringMatch("R"))
                     {
@@ -427,34 +904,7 @@ void TextParser_Handle(void)
                         if (ConvertStringToHex(&len))
                         {
                             //Length Found
-                            I2C0_Host_Read(addr, serialBytes, len);
-                            while (I2C0_Host_IsBusy())
-                            {
-                                I2C0_Host_Tasks();
-                            }
-
-                            switch (I2C0_Host_ErrorGet())
-                            {
-                                case I2C_ERROR_NONE:
-                                {
-                                    commandStatus = COMMAND_OK;
-                                    break;
-                                }
-                                case I2C_ERROR_ADDR_NACK:
-                                {
-                                    commandStatus = COMMAND_ADDR_NACK;
-                                    break;
-                                }
-                                case I2C_ERROR_DATA_NACK:
-                                {
-                                    commandStatus = COMMAND_DATA_NACK;
-                                    break;
-                                }
-                                default:
-                                {
-
-                                }
-                            }
+                            commandStatus = GetCommandStatus(SerialBus_I2CRead(addr, serialBytes, len));
                         }
                     }
                     else if (StringMatch("W"))
@@ -470,34 +920,7 @@ void TextParser_Handle(void)
                         if (len > 0)
                         {
                             //Bytes found
-                            I2C0_Host_Write(addr, serialBytes, len);
-                            while (I2C0_Host_IsBusy())
-                            {
-                                I2C0_Host_Tasks();
-                            }
-                            
-                            switch (I2C0_Host_ErrorGet())
-                            {
-                                case I2C_ERROR_NONE:
-                                {
-                                    commandStatus = COMMAND_OK;
-                                    break;
-                                }
-                                case I2C_ERROR_ADDR_NACK:
-                                {
-                                    commandStatus = COMMAND_ADDR_NACK;
-                                    break;
-                                }
-                                case I2C_ERROR_DATA_NACK:
-                                {
-                                    commandStatus = COMMAND_DATA_NACK;
-                                    break;
-                                }
-                                default:
-                                {
-
-                                }
-                            }
+                            commandStatus = GetCommandStatus(SerialBus_I2CWrite(addr, serialBytes, len));
                         }
                     }
                     else if (StringMatch("WR"))
@@ -517,34 +940,54 @@ void TextParser_Handle(void)
                             //Read Length is in byte 2
                             len = serialBytes[1];
                             
-                            I2C0_Host_WriteRead(addr, serialBytes, 1, (serialBytes),len);
-                            while (I2C0_Host_IsBusy())
-                            {
-                                I2C0_Host_Tasks();
-                            }
+                            commandStatus = GetCommandStatus(SerialBus_I2CWriteRead(addr, serialBytes, 1, serialBytes, len));
+                        }
+                    }
+                    else if (updateType != UPDATE_NONE)
+                    {
+                        //Read-Modify-Write
+                        uint8_t mask, value;
+                        
+                        AdvanceBuffer();
+                        
+                        serialType = SERIAL_UPDATE;
+                        
+                        //Get Register Address, then the Mask / Value
+                        len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
+                        
+                        if ((len > 1) && (GetUpdateParameters(updateType, &serialBytes[1], len - 1, &mask, &value)))
+                        {
+                            commandStatus = GetCommandStatus(SerialBus_I2CUpdate(addr, serialBytes[0], mask, value, 
+                                    &serialBytes[0], &serialBytes[1]));
+                            len = 2;
+                        }
+                    }
+                    else if (StringMatch("PROG"))
+                    {
+                        //EEPROM Page Program
+                        AdvanceBuffer();
+                        
+                        serialType = SERIAL_I2C_PROGRAM;
+                        
+                        //Get Page Size, Address Length, Address and Data
+                        len = ConvertTextToHexArray(serialBytes, MAX_SERIAL_PARAMETERS);
+                        
+                        uint8_t pageSize = serialBytes[0];
+                        uint8_t addrLen = serialBytes[1];
 
-                            switch (I2C0_Host_ErrorGet())
+                        if ((len > 2) && (pageSize > 0) && (pageSize <= I2C_EEPROM_MAX_PAGE_SIZE) 
+                                && (addrLen > 0) && (addrLen <= I2C_EEPROM_MAX_ADDR_LENGTH) && (len > (2 + addrLen)))
+                        {
+                            //Memory Address is MSB first
+                            uint16_t memAddr = serialBytes[2];
+                            
+                            if (addrLen == 2)
                             {
-                                case I2C_ERROR_NONE:
-                                {
-                                    commandStatus = COMMAND_OK;
-                                    break;
-                                }
-                                case I2C_ERROR_ADDR_NACK:
-                                {
-                                    commandStatus = COMMAND_ADDR_NACK;
-                                    break;
-                                }
-                                case I2C_ERROR_DATA_NACK:
-                                {
-                                    commandStatus = COMMAND_DATA_NACK;
-                                    break;
-                                }
-                                default:
-                                {
-
-                                }
+                                memAddr = (memAddr << 8) | serialBytes[3];
                             }
+                            
+                            commandStatus = GetCommandStatus(I2CEEPROM_Program(addr, memAddr, addrLen, pageSize, 
+                                    &serialBytes[2 + addrLen], len - (2 + addrLen)));
                         }
                     }
                 }
@@ -552,69 +995,179 @@ void TextParser_Handle(void)
             }
         }
     }
+    else if (StringMatch("UART"))
+    {
+        //Transparent USART Bridge, runs until the host drops DTR
+        serialType = SERIAL_UART_BRIDGE;
+        commandStatus = (UARTBridge_Start()) ? COMMAND_OK : COMMAND_UART_CONFIG;
+    }
+    else if (StringMatch("OUTPUT"))
+    {
+        //Output Policy while DTR is low
+        serialType = SERIAL_OUTPUT;
+        commandStatus = COMMAND_OK;
+        
+        if (AdvanceBuffer())
+        {
+            if (StringMatch("PARK"))
+            {
+                TextQueue_SetPolicy(TEXT_QUEUE_PARK);
+            }
+            else if (StringMatch("DROP"))
+            {
+                TextQueue_SetPolicy(TEXT_QUEUE_DROP);
+            }
+            else if (StringMatch("STREAM"))
+            {
+                TextQueue_SetPolicy(TEXT_QUEUE_STREAM);
+            }
+            else
+            {
+                commandStatus = COMMAND_INVALID;
+            }
+        }
+        
+        //Dropped character count (MSB first)
+        serialBytes[0] = (TextQueue_GetDropped() >> 8);
+        serialBytes[1] = (TextQueue_GetDropped() & 0xFF);
+        len = 2;
+    }
+    else if (StringMatch("USB"))
+    {
+        //USB Error Recovery counters (MSB first)
+        const usb_recovery_stats_t* stats = USBRecovery_GetStats();
+        
+        serialType = SERIAL_USB_RECOVERY;
+        commandStatus = COMMAND_OK;
+        
+        serialBytes[0] = (stats->pipeResets >> 8);
+        serialBytes[1] = (stats->pipeResets & 0xFF);
+        serialBytes[2] = (stats->usbResets >> 8);
+        serialBytes[3] = (stats->usbResets & 0xFF);
+        serialBytes[4] = (stats->failedResets >> 8);
+        serialBytes[5] = (stats->failedResets & 0xFF);
+        serialBytes[6] = (uint8_t) stats->lastError;
+        serialBytes[7] = (stats->lastRecoveryMs >> 8);
+        serialBytes[8] = (stats->lastRecoveryMs & 0xFF);
+        serialBytes[9] = (stats->maxRecoveryMs >> 8);
+        serialBytes[10] = (stats->maxRecoveryMs & 0xFF);
+        len = 11;
+    }
     
-    switch (commandStatus)
+    else if (StringMatch("TIME"))
     {
-        case COMMAND_OK:
+        //Timestamp of the last bus transaction, optionally printed after each bus command
+        serialType = SERIAL_TIME;
+        commandStatus = COMMAND_OK;
+        
+        if (AdvanceBuffer())
         {
-            //Print results
-            switch (serialType)
+            if (StringMatch("ON"))
             {
-                case SERIAL_SPI_EEPROM:
-                case SERIAL_SPI_DAC:
-                case SERIAL_SPI_USD:
-                {
-                    //SPI Communication
-                    LoadDataToOutputQueue(serialBytes, len);
-                    break;
-                }
-                case SERIAL_I2C_READ:
-                {
-                    //I2C Read
-                    LoadDataToOutputQueue(serialBytes, len);
-                    break;
-                }
-                case SERIAL_I2C_WRITE:
-                {
-                    //I2C Write
-                    TextQueue_AddText("> OK\r\n");
-                    break;
-                }
-                case SERIAL_I2C_WRITE_READ:
+                printTimestamp = true;
+            }
+            else if (StringMatch("OFF"))
+            {
+                printTimestamp = false;
+            }
+            else
+            {
+                commandStatus = COMMAND_INVALID;
+            }
+        }
+        
+        LoadTimestamp(serialBytes);
+        len = USB_TIMESTAMP_SIZE;
+    }
+#if PROFILER_ENABLE
+    else if (StringMatch("PROF"))
+    {
+        //Profiler statistics (MSB first)
+        uint8_t section;
+        
+        serialType = SERIAL_PROFILER;
+        len = 0;
+        
+        if (AdvanceBuffer())
+        {
+            if (StringMatch("CLR"))
+            {
+                //Clear all sections
+                Profiler_Initialize();
+                commandStatus = COMMAND_OK;
+            }
+            else if ((ConvertStringToHex(&section)) && (section < PROFILER_SECTIONS))
+            {
+                if (AdvanceBuffer())
                 {
-                    //I2C Write/Read
-                    LoadDataToOutputQueue(serialBytes, len);
-                    break;
+                    if (StringMatch("HIST"))
+                    {
+                        //Histogram, read before the summary as the summary clears it
+                        uint16_t buckets[PROFILER_BUCKETS];
+                        
+                        Profiler_GetHistogram((profiler_section_t) section, buckets);
+                        for (uint8_t i = 0; i < PROFILER_BUCKETS; i++)
+                        {
+                            serialBytes[len++] = (buckets[i] >> 8);
+                            serialBytes[len++] = (buckets[i] & 0xFF);
+                        }
+                        commandStatus = COMMAND_OK;
+                    }
                 }
-                default:
+                else
                 {
-                    TextQueue_AddText("Unknown communication type\r\n");
+                    //Count, min, avg and max in us, then clear the section
+                    profiler_summary_t summary;
+                    
+                    Profiler_GetSummary((profiler_section_t) section, &summary);
+                    Profiler_Reset((profiler_section_t) section);
+                    
+                    serialBytes[0] = (summary.count >> 8);
+                    serialBytes[1] = (summary.count & 0xFF);
+                    serialBytes[2] = (summary.min >> 8);
+                    serialBytes[3] = (summary.min & 0xFF);
+                    serialBytes[4] = (summary.avg >> 8);
+                    serialBytes[5] = (summary.avg & 0xFF);
+                    serialBytes[6] = (summary.max >> 8);
+                    serialBytes[7] = (summary.max & 0xFF);
+                    len = 8;
+                    commandStatus = COMMAND_OK;
                 }
             }
-            break;
-        }
-        case COMMAND_INVALID:
-        {
-            TextQueue_AddText("Command parsing error\r\n");
-            break;
-        }
-        case COMMAND_ADDR_NACK:
-        {
-            TextQueue_AddText("I2C NACK error\r\n");
-            break;
-        }
-        case COMMAND_DATA_NACK:
-        {
-            TextQueue_AddText("I2C communication error\r\n");
-            break;
         }
-        default:
+    }
+#endif
+#if TRACE_ENABLE
+    else if (StringMatch("TRACE"))
+    {
+        //Oldest trace events, removed once printed
+        //Recording pauses while each TRACE runs, events from other commands are kept
+        serialType = SERIAL_TRACE;
+        commandStatus = COMMAND_OK;
+        len = 0;
+        
+        while ((len < (TRACE_ENTRIES_PER_LINE * TRACE_ENTRY_SIZE)) && (Trace_Read(&serialBytes[len])))
         {
-            //Shouldn't get here
-            TextQueue_AddText("Unknown error\r\n");
+            len += TRACE_ENTRY_SIZE;
         }
     }
+#endif
+    else if (StringMatch("STATS"))
+    {
+        //Error counters (MSB first), not cleared
+        serialType = SERIAL_STATS;
+        commandStatus = COMMAND_OK;
+        
+        Stats_Write(serialBytes, true);
+        len = STATS_COUNTERS * STATS_COUNTER_SIZE;
+    }
     
-    //Clean-up
-    textLength = 0;
+    PrintCommandResult(serialType, commandStatus, serialBytes, len);
+    
+#if TRACE_ENABLE
+    if (serialType == SERIAL_TRACE)
+    {
+        Trace_Resume();
+    }
+#endif
 }
\ No newline at end of file
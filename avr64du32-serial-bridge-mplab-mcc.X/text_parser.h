@@ -10,6 +10,9 @@ extern "C" {
 #define PARSER_BUFFER_SIZE 128
     
 #define MAX_SERIAL_PARAMETERS 32
+    
+//Poll timeouts are given in units of 10 ms
+#define POLL_TIMEOUT_UNIT_MS 10
         
     //Initialize the text parser
     void TextParser_Initialize(void);
@@ -1,39 +1,132 @@
 #include "text_queue.h"
 
 #include "ringBuffer.h"
+#include "usb_cdc.h"
 #include "usb_cdc_virtual_serial_port.h"
 #include "circular_buffer.h"
+#include "stats.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 
 static char buffer[TEXT_QUEUE_SIZE];
 static rint_buffer_t ringBuffer;
 
+static text_queue_policy_t policy = TEXT_QUEUE_STREAM;
+static bool lastDTR = false;
+
+//Counts LEN characters as dropped
+static void TextQueue_CountDropped(uint16_t len)
+{
+    Stats_Add(STATS_TEXT_QUEUE_DROPPED, len);
+}
+
+//Discards everything waiting in the queue
+static void TextQueue_Discard(void)
+{
+    TextQueue_CountDropped(ringBuffer_charsToRead(&ringBuffer));
+    ringBuffer_flushReadBuffer(&ringBuffer);
+}
+
 //Initializes the Text Queue
 void TextQueue_Initialize(void)
 {
     ringBuffer_createBuffer(&ringBuffer, buffer, TEXT_QUEUE_SIZE);
+    lastDTR = false;
 }
 
 //Adds text to the Transmit Queue
 void TextQueue_AddText(const char* text)
 {
-    ringBuffer_loadString(&ringBuffer, text);
+    uint16_t len = strlen(text);
+    
+    //1 slot is always kept free, a full ring would look empty
+    ring_buffer_size_t freeSpace = (TEXT_QUEUE_SIZE - 1) - ringBuffer_charsToRead(&ringBuffer);
+    
+    if ((policy == TEXT_QUEUE_DROP) && (!USB_CDCDataTerminalReady()))
+    {
+        //Nobody is listening
+        TextQueue_CountDropped(len);
+        return;
+    }
+    
+    if (len > freeSpace)
+    {
+        //Queue full, drop the new text rather than overwriting queued text
+        TextQueue_CountDropped(len);
+        
+        //Report it to the host
+        USB_CDCSerialStateEvent(USB_CDC_SERIAL_STATE_OVERRUN_bm);
+        return;
+    }
+    
+    if (ringBuffer_loadString(&ringBuffer, text))
+    {
+        //Overwrote queued text, only if the free space check above is wrong
+        TextQueue_CountDropped(len);
+    }
+}
+
+//Reports the bridge as ready (DSR) with the carrier present (DCD)
+//DCD stays set, a drop would make the host hang up the port, responses are signaled with RI instead
+static void TextQueue_UpdateSerialState(void)
+{
+    USB_CDCSerialStateSet(USB_CDC_SERIAL_STATE_TX_CARRIER_bm | USB_CDC_SERIAL_STATE_RX_CARRIER_bm);
 }
 
 //Loads text from the internal queue into the Tx Buffer
 void TextQueue_LoadTransmitBuffer(void)
 {
-    while (!ringBuffer_isEmpty(&ringBuffer))
+    bool dtr = USB_CDCDataTerminalReady();
+    
+    if ((dtr) && (!lastDTR) && (policy != TEXT_QUEUE_PARK))
     {
-        if (USB_CDCWrite(ringBuffer_peekChar(&ringBuffer)) == CDC_SUCCESS)
-        {
-            //Advance to next character
-            ringBuffer_incrementReadIndex(&ringBuffer);
-        }
-        else
+        //Port reopened, start the new session without the old output
+        TextQueue_Discard();
+        USB_CDCTransmitFlush();
+    }
+    lastDTR = dtr;
+    
+    if ((dtr) || (policy == TEXT_QUEUE_STREAM))
+    {
+        while (!ringBuffer_isEmpty(&ringBuffer))
         {
-            //Buffer error - exit and try again later
-            return;
+            if (USB_CDCWrite(ringBuffer_peekChar(&ringBuffer)) == CDC_SUCCESS)
+            {
+                //Advance to next character
+                ringBuffer_incrementReadIndex(&ringBuffer);
+            }
+            else
+            {
+                //Buffer error - exit and try again later
+                break;
+            }
         }
     }
+    else if (policy == TEXT_QUEUE_DROP)
+    {
+        //Port closed - discard anything queued before DTR fell
+        TextQueue_Discard();
+    }
+    else
+    {
+        //Port closed - text is parked until DTR is set
+    }
+    
+    TextQueue_UpdateSerialState();
 }
 
+//Sets the output policy
+void TextQueue_SetPolicy(text_queue_policy_t newPolicy)
+{
+    policy = newPolicy;
+}
+
+//Returns the number of characters dropped since startup, saturated to 16 bits
+uint16_t TextQueue_GetDropped(void)
+{
+    uint32_t dropped = Stats_Get(STATS_TEXT_QUEUE_DROPPED);
+    
+    return (dropped > UINT16_MAX) ? UINT16_MAX : (uint16_t) dropped;
+}
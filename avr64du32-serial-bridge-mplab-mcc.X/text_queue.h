@@ -5,17 +5,34 @@
 extern "C" {
 #endif
     
+#include <stdint.h>
+    
 #define TEXT_QUEUE_SIZE 128
     
+    //What happens to output while the host has DTR low (port closed)
+    typedef enum {
+        TEXT_QUEUE_PARK = 0, TEXT_QUEUE_DROP, TEXT_QUEUE_STREAM
+    } text_queue_policy_t;
+    
     //Initializes the Text Queue
     void TextQueue_Initialize(void);
 
     //Adds text to the Transmit Queue
+    //Text that doesn't fit is dropped whole and counted
     void TextQueue_AddText(const char* text);
     
     //Loads text from the internal queue into the Tx Buffer
     void TextQueue_LoadTransmitBuffer(void);
     
+    //Sets the output policy
+    //PARK keeps the output in the queue until DTR is set
+    //DROP discards output while DTR is low, and stale output when the port is reopened
+    //STREAM ignores DTR, stale output is discarded when the port is reopened (default)
+    void TextQueue_SetPolicy(text_queue_policy_t newPolicy);
+    
+    //Returns the number of characters dropped since startup, from STATS_TEXT_QUEUE_DROPPED saturated to 16 bits
+    uint16_t TextQueue_GetDropped(void);
+    
 #ifdef	__cplusplus
 }
 #endif
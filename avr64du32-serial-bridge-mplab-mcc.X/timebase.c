@@ -0,0 +1,182 @@
+#include "timebase.h"
+
+#include <xc.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "mcc_generated_files/system/system.h"
+#include "scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    timebase_callback_t callback;
+    uint32_t start;
+    uint32_t ms;
+} timebase_timer_t;
+
+//Milliseconds since startup
+static volatile uint32_t millis = 0;
+
+//Scheduled callbacks, free if CALLBACK is NULL
+static timebase_timer_t timers[TIMEBASE_MAX_TIMERS];
+
+//TCB0 period match, once per millisecond
+ISR(TCB0_INT_vect)
+{
+    //The interrupt flag has to be cleared manually
+    TCB0.INTFLAGS = TCB_CAPT_bm;
+    
+    millis++;
+    Scheduler_Post(SCHEDULER_EVENT_TICK);
+}
+
+//Reads the milliseconds and the tick timer count at the same instant
+static void Timebase_Read(uint32_t* ms, uint16_t* count)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        *ms = millis;
+        *count = TCB0.CNT;
+        
+        //The counter has wrapped, but the tick has not been counted yet
+        if (TCB0.INTFLAGS & TCB_CAPT_bm)
+        {
+            (*ms)++;
+            *count = TCB0.CNT;
+        }
+    }
+}
+
+//Initializes the 1 ms system tick (TCB0)
+void Timebase_Initialize(void)
+{
+    millis = 0;
+    
+    for (uint8_t i = 0; i < TIMEBASE_MAX_TIMERS; i++)
+    {
+        timers[i].callback = NULL;
+    }
+    
+    //Periodic interrupt mode, F_CPU / 1000 counts per period
+    TCB0.CTRLA = 0x00;
+    TCB0.CCMP = (uint16_t) ((F_CPU / 1000UL) - 1UL);
+    TCB0.CNT = 0;
+    TCB0.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB0.INTFLAGS = (TCB_CAPT_bm | TCB_OVF_bm);
+    TCB0.INTCTRL = TCB_CAPT_bm;
+    TCB0.CTRLA = (TCB_CLKSEL_DIV1_gc | TCB_ENABLE_bm);
+}
+
+//Returns the number of milliseconds since startup
+uint32_t Timebase_GetMillis(void)
+{
+    uint32_t result;
+    
+    //32-bit value is updated in the ISR
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        result = millis;
+    }
+    
+    return result;
+}
+
+//Returns the number of microseconds since startup, wraps around after about 71 minutes
+uint32_t Timebase_GetMicros(void)
+{
+    uint32_t ms;
+    uint16_t count;
+    
+    Timebase_Read(&ms, &count);
+    return (ms * 1000UL) + (count / (uint16_t) TIMEBASE_TICKS_PER_US);
+}
+
+//Returns the number of tick timer counts since startup, wraps around after about 3 minutes at 24 MHz
+uint32_t Timebase_GetCycles(void)
+{
+    uint32_t ms;
+    uint16_t count;
+    
+    Timebase_Read(&ms, &count);
+    return (ms * TIMEBASE_US_TO_TICKS(1000)) + count;
+}
+
+//Returns true if at least MS milliseconds have passed since START
+bool Timebase_HasElapsed(uint32_t start, uint32_t ms)
+{
+    //Unsigned math handles the wrap-around
+    return ((Timebase_GetMillis() - start) >= ms);
+}
+
+//Returns true if at least US microseconds have passed since START (from Timebase_GetMicros)
+bool Timebase_HasElapsedMicros(uint32_t start, uint32_t us)
+{
+    //Unsigned math handles the wrap-around
+    return ((Timebase_GetMicros() - start) >= us);
+}
+
+//Calls CALLBACK from Timebase_Task once MS milliseconds have passed
+bool Timebase_Schedule(timebase_callback_t callback, uint32_t ms)
+{
+    timebase_timer_t* timer = NULL;
+    
+    if (callback == NULL)
+    {
+        return false;
+    }
+    
+    for (uint8_t i = 0; i < TIMEBASE_MAX_TIMERS; i++)
+    {
+        if (timers[i].callback == callback)
+        {
+            //Already scheduled, move it
+            timer = &timers[i];
+            break;
+        }
+        else if ((timers[i].callback == NULL) && (timer == NULL))
+        {
+            timer = &timers[i];
+        }
+    }
+    
+    if (timer == NULL)
+    {
+        return false;
+    }
+    
+    timer->callback = callback;
+    timer->start = Timebase_GetMillis();
+    timer->ms = ms;
+    return true;
+}
+
+//Removes CALLBACK if it is scheduled
+void Timebase_Cancel(timebase_callback_t callback)
+{
+    for (uint8_t i = 0; i < TIMEBASE_MAX_TIMERS; i++)
+    {
+        if (timers[i].callback == callback)
+        {
+            timers[i].callback = NULL;
+        }
+    }
+}
+
+//Runs the callbacks that are due, call on each SCHEDULER_EVENT_TICK
+void Timebase_Task(void)
+{
+    timebase_callback_t callback;
+    
+    for (uint8_t i = 0; i < TIMEBASE_MAX_TIMERS; i++)
+    {
+        if ((timers[i].callback != NULL) && (Timebase_HasElapsed(timers[i].start, timers[i].ms)))
+        {
+            //Free the timer first, so the callback can schedule itself again
+            callback = timers[i].callback;
+            timers[i].callback = NULL;
+            callback();
+        }
+    }
+}
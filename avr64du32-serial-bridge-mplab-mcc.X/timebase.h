@@ -0,0 +1,60 @@
+#ifndef TIMEBASE_H
+#define	TIMEBASE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcc_generated_files/system/clock.h"
+
+//Counts of the tick timer (TCB0) per microsecond
+#define TIMEBASE_TICKS_PER_US (F_CPU / 1000000UL)
+
+//Converts US microseconds (below 1000) to tick timer counts
+#define TIMEBASE_US_TO_TICKS(us) ((uint16_t) ((us) * TIMEBASE_TICKS_PER_US))
+
+//Number of callbacks that can be scheduled at the same time
+#define TIMEBASE_MAX_TIMERS 4
+
+    //Called from Timebase_Task once its time has passed
+    typedef void (*timebase_callback_t)(void);
+
+    //Initializes the 1 ms system tick (TCB0)
+    void Timebase_Initialize(void);
+
+    //Returns the number of milliseconds since startup
+    uint32_t Timebase_GetMillis(void);
+
+    //Returns the number of microseconds since startup, wraps around after about 71 minutes
+    uint32_t Timebase_GetMicros(void);
+
+    //Returns the number of tick timer counts since startup, wraps around after about 3 minutes at 24 MHz
+    //Cheaper than Timebase_GetMicros, for timing code
+    uint32_t Timebase_GetCycles(void);
+
+    //Returns true if at least MS milliseconds have passed since START
+    bool Timebase_HasElapsed(uint32_t start, uint32_t ms);
+
+    //Returns true if at least US microseconds have passed since START (from Timebase_GetMicros)
+    //START is truncated to the microsecond, so ask for one more to be sure of US
+    bool Timebase_HasElapsedMicros(uint32_t start, uint32_t us);
+
+    //Calls CALLBACK from Timebase_Task once MS milliseconds have passed
+    //A callback that is already scheduled is moved to the new time
+    //Returns false if all timers are in use, not for use in interrupts
+    bool Timebase_Schedule(timebase_callback_t callback, uint32_t ms);
+
+    //Removes CALLBACK if it is scheduled
+    void Timebase_Cancel(timebase_callback_t callback);
+
+    //Runs the callbacks that are due, call on each SCHEDULER_EVENT_TICK
+    void Timebase_Task(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TIMEBASE_H */
+
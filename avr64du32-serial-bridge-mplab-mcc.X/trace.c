@@ -0,0 +1,133 @@
+#include "trace.h"
+
+#include <usb_trace.h>
+#include "mcc_generated_files/i2c_host/twi0_trace.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if USB_TRACE_ENABLE
+//Called by the USB stack, USB_TRACE_EVENT_t lists the USB events of trace_event_t in the same order
+void USB_TraceEvent(USB_TRACE_EVENT_t event, uint8_t payload)
+{
+    (void) event;
+    (void) payload;
+    TRACE_EVENT((trace_event_t) (TRACE_USB_TRANSFER_START + event), payload);
+}
+#endif
+
+#if TWI0_TRACE_ENABLE
+//Called by the TWI0 driver, TWI0_TRACE_STATE is the only event
+void TWI0_TraceEvent(TWI0_TRACE_EVENT_t event, uint8_t payload)
+{
+    (void) event;
+    (void) payload;
+    TRACE_EVENT(TRACE_I2C_STATE, payload);
+}
+#endif
+
+#if TRACE_ENABLE
+
+#include <util/atomic.h>
+#include "timebase.h"
+
+typedef struct {
+    uint32_t time;
+    uint8_t event;
+    uint8_t payload;
+} trace_entry_t;
+
+static trace_entry_t ring[TRACE_SIZE];
+
+//Position of the oldest event and number of events in the ring
+static volatile uint8_t tail = 0;
+static volatile uint8_t count = 0;
+
+//Cleared by Trace_Pause while a readout command runs, so the readout does not trace itself
+static volatile bool recording = true;
+
+//Clears the ring and starts recording
+void Trace_Initialize(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        tail = 0;
+        count = 0;
+        recording = true;
+    }
+}
+
+//Adds EVENT to the ring, stamped with the tick timer count (Timebase_GetCycles)
+void Trace_Record(trace_event_t event, uint8_t payload)
+{
+    uint32_t time = Timebase_GetCycles();
+    uint8_t head;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (recording)
+        {
+            head = tail + count;
+            if (head >= TRACE_SIZE)
+            {
+                head -= TRACE_SIZE;
+            }
+
+            ring[head].time = time;
+            ring[head].event = (uint8_t) event;
+            ring[head].payload = payload;
+
+            if (count < TRACE_SIZE)
+            {
+                count++;
+            }
+            else
+            {
+                //Full, the oldest event was overwritten
+                tail = (tail + 1 >= TRACE_SIZE) ? 0 : (tail + 1);
+            }
+        }
+    }
+}
+
+//Stops recording until Trace_Resume, events are dropped in between
+void Trace_Pause(void)
+{
+    recording = false;
+}
+
+//Starts recording again after Trace_Pause
+void Trace_Resume(void)
+{
+    recording = true;
+}
+
+//Moves the oldest event to DATA (TRACE_ENTRY_SIZE bytes), returns false once the ring is empty
+bool Trace_Read(uint8_t* data)
+{
+    bool result = false;
+    trace_entry_t* entry;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (count != 0)
+        {
+            entry = &ring[tail];
+
+            data[0] = (entry->time >> 24);
+            data[1] = (entry->time >> 16) & 0xFF;
+            data[2] = (entry->time >> 8) & 0xFF;
+            data[3] = (entry->time & 0xFF);
+            data[4] = entry->event;
+            data[5] = entry->payload;
+
+            tail = (tail + 1 >= TRACE_SIZE) ? 0 : (tail + 1);
+            count--;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef TRACE_H
+#define	TRACE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Set to 0 to compile the trace out, TRACE_EVENT then expands to nothing
+//The USB stack events are reported through USB_TraceEvent (usb_trace.h), see USB_TRACE_ENABLE in usb_config.h
+//The I2C host states are reported through TWI0_TraceEvent (twi0_trace.h), see TWI0_TRACE_ENABLE there
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+//Events kept in RAM, the oldest event is overwritten once the ring is full
+#define TRACE_SIZE 64
+
+//Bytes of each event sent by Trace_Read, time (4, MSB first), event, payload
+#define TRACE_ENTRY_SIZE 6
+
+    //Recorded events, the payload is in the comment
+    //The first 4 are the USB stack events, in the order of USB_TRACE_EVENT_t
+    typedef enum {
+        TRACE_USB_TRANSFER_START = 0,   //Endpoint address, bit 7 set for IN
+        TRACE_USB_TRANSFER_END,         //Endpoint address, bit 7 set for IN
+        TRACE_CIRCBUF_FULL,             //Low byte of the buffer address, the last free byte was used
+        TRACE_CIRCBUF_EMPTY,            //Low byte of the buffer address, the last byte was read
+        TRACE_I2C_START,                //Address byte, 7-bit address and R/W bit
+        TRACE_I2C_END,                  //Transaction status (bus_status_t)
+        TRACE_SPI_START,                //SPI target
+        TRACE_SPI_END,                  //Bytes exchanged
+        TRACE_COMMAND_START,            //First character of the command
+        TRACE_COMMAND_END,              //Command status
+        TRACE_I2C_STATE,                //I2C host state after a start or an interrupt (i2c_event_states_t)
+        TRACE_EVENTS
+    } trace_event_t;
+
+#if TRACE_ENABLE
+//Records EVENT with PAYLOAD, safe to use from interrupts
+#define TRACE_EVENT(event, payload) Trace_Record((event), (uint8_t) (payload))
+#else
+#define TRACE_EVENT(event, payload)
+#endif
+
+    //Clears the ring and starts recording
+    void Trace_Initialize(void);
+
+    //Adds EVENT to the ring, stamped with the tick timer count (Timebase_GetCycles)
+    void Trace_Record(trace_event_t event, uint8_t payload);
+
+    //Stops recording until Trace_Resume, events are dropped in between
+    void Trace_Pause(void);
+
+    //Starts recording again after Trace_Pause
+    void Trace_Resume(void);
+
+    //Moves the oldest event to DATA (TRACE_ENTRY_SIZE bytes), returns false once the ring is empty
+    bool Trace_Read(uint8_t* data);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRACE_H */
+
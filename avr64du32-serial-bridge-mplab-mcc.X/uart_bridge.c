@@ -0,0 +1,232 @@
+#include "uart_bridge.h"
+
+#include <xc.h>
+#include "mcc_generated_files/system/system.h"
+#include "usart0.h"
+#include "timebase.h"
+#include "scheduler.h"
+#include "usb_cdc.h"
+#include "usb_cdc_virtual_serial_port.h"
+#if USB_CDC_DATA_PORT_ENABLE
+#include "usb_cdc_data_port.h"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//CDC function used by the bridge
+#if USB_CDC_DATA_PORT_ENABLE
+//The data port is used, so the command port stays with the text parser
+#define UART_BRIDGE_CDC(function) USB_CDCDataPort##function
+#else
+#define UART_BRIDGE_CDC(function) USB_CDC##function
+#endif
+
+static volatile bool lineCodingPending = false;
+static bool isActive = false;
+static bool lastDTR = false;
+
+//Data from the USART waiting for room in the CDC Tx Buffer
+static uint8_t hostBlock[UART_BRIDGE_BLOCK_SIZE];
+static uint8_t hostLength = 0;
+static uint8_t hostOffset = 0;
+
+//Called by the USB stack once SET_LINE_CODING has completed
+static void UARTBridge_LineCodingChanged(void)
+{
+    lineCodingPending = true;
+}
+
+//Configures USART0 from the CDC line coding
+static bool UARTBridge_ApplyLineCoding(void)
+{
+    uint32_t baud = UART_BRIDGE_CDC(GetBaud)();
+    uint8_t dataBits = UART_BRIDGE_CDC(GetDataBits)();
+    
+    if (baud == 0)
+    {
+        //Line coding not set by the host yet
+        baud = UART_BRIDGE_DEFAULT_BAUD;
+    }
+    
+    if ((dataBits < USB_CDC_LINE_CODING_5_DATA_BITS) || (dataBits > USB_CDC_LINE_CODING_8_DATA_BITS))
+    {
+        return false;
+    }
+    
+    //CDC parity and stop bit codes use the same order as the UART types
+    if (!USART0_BaudRateSet(baud))
+    {
+        return false;
+    }
+    if (!USART0_ParityModeSet((uart_parity_t) UART_BRIDGE_CDC(GetParity)()))
+    {
+        return false;
+    }
+    
+    USART0_StopBitsSet((uart_stop_bits_t) UART_BRIDGE_CDC(GetStopBits)());
+    return USART0_CharacterSizeSet((uart_data_bits_t) (UART_DATA_5_BITS + (dataBits - USB_CDC_LINE_CODING_5_DATA_BITS)));
+}
+
+//Reports USART receive errors to the host
+static void UARTBridge_ReportErrors(void)
+{
+    uint8_t errors = USART0_ErrorGet();
+    uint16_t events = 0;
+    
+    if (errors & USART0_ERROR_PARITY_bm)
+    {
+        events |= USB_CDC_SERIAL_STATE_PARITY_bm;
+    }
+    if (errors & USART0_ERROR_FRAMING_bm)
+    {
+        events |= USB_CDC_SERIAL_STATE_FRAMING_bm;
+    }
+    if (errors & USART0_ERROR_OVERRUN_bm)
+    {
+        events |= USB_CDC_SERIAL_STATE_OVERRUN_bm;
+    }
+    
+    UART_BRIDGE_CDC(SerialStateEvent)(events);
+}
+
+//Scheduled every UART_BRIDGE_PICKUP_MS while the bridge runs
+static void UARTBridge_PickUp(void)
+{
+    Scheduler_Post(SCHEDULER_EVENT_UART);
+    Timebase_Schedule(&UARTBridge_PickUp, UART_BRIDGE_PICKUP_MS);
+}
+
+//Initializes the USART bridge
+void UARTBridge_Initialize(void)
+{
+    USART0_Initialize();
+    
+    isActive = false;
+    lineCodingPending = false;
+    UART_BRIDGE_CDC(LineCodingCallbackRegister)(&UARTBridge_LineCodingChanged);
+}
+
+//Applies the CDC line coding to USART0 and starts forwarding data
+bool UARTBridge_Start(void)
+{
+    lineCodingPending = false;
+    
+    if (!UARTBridge_ApplyLineCoding())
+    {
+        return false;
+    }
+    
+    hostLength = 0;
+    hostOffset = 0;
+    lastDTR = UART_BRIDGE_CDC(DataTerminalReady)();
+    
+#if !USB_CDC_DATA_PORT_ENABLE
+    //Received data goes to the USART only
+    USB_CDCEchoEnable(false);
+#endif
+    USART0_Enable();
+    
+    //Carrier is up while bridging
+    UART_BRIDGE_CDC(SerialStateSet)(USB_CDC_SERIAL_STATE_TX_CARRIER_bm | USB_CDC_SERIAL_STATE_RX_CARRIER_bm);
+    
+    isActive = true;
+    Timebase_Schedule(&UARTBridge_PickUp, UART_BRIDGE_PICKUP_MS);
+    return true;
+}
+
+//Stops forwarding data and returns the CDC port to the text parser
+void UARTBridge_Stop(void)
+{
+    isActive = false;
+    Timebase_Cancel(&UARTBridge_PickUp);
+    
+    USART0_Disable();
+#if USB_CDC_DATA_PORT_ENABLE
+    //Carrier drops on the data port
+    USB_CDCDataPortSerialStateSet(0);
+#else
+    USB_CDCEchoEnable(true);
+#endif
+}
+
+//Returns true while the bridge is running
+bool UARTBridge_IsActive(void)
+{
+    return isActive;
+}
+
+//Moves data between the CDC endpoints and USART0
+bool UARTBridge_Handle(void)
+{
+    uint8_t block[UART_BRIDGE_BLOCK_SIZE];
+    uint8_t len;
+    bool more = false;
+    bool dtr = UART_BRIDGE_CDC(DataTerminalReady)();
+    
+    if (!isActive)
+    {
+        return false;
+    }
+    
+    //Host closed the port
+    if ((lastDTR) && (!dtr))
+    {
+        UARTBridge_Stop();
+        return false;
+    }
+    lastDTR = dtr;
+    
+    if (lineCodingPending)
+    {
+        //Wait for the last frame to leave before changing the format
+        if (USART0_IsTxDone())
+        {
+            lineCodingPending = false;
+            if (!UARTBridge_ApplyLineCoding())
+            {
+                //Unsupported format, signal it as a framing error
+                UART_BRIDGE_CDC(SerialStateEvent)(USB_CDC_SERIAL_STATE_FRAMING_bm);
+            }
+        }
+    }
+    else
+    {
+        //Host to USART, only take what fits so the OUT endpoint is held off when the USART falls behind
+        len = USART0_TxFreeGet();
+        if (len > UART_BRIDGE_BLOCK_SIZE)
+        {
+            len = UART_BRIDGE_BLOCK_SIZE;
+        }
+        
+        len = UART_BRIDGE_CDC(ReadBlock)(block, len);
+        USART0_WriteBlock(block, len);
+        
+        //A full block may have more data behind it
+        more = (len == UART_BRIDGE_BLOCK_SIZE);
+    }
+    
+    //USART to host, paused while the host holds DTR or RTS low
+    if ((hostLength == 0) && (dtr) && (UART_BRIDGE_CDC(RequestToSend)()))
+    {
+        hostLength = USART0_ReadBlock(hostBlock, UART_BRIDGE_BLOCK_SIZE);
+        hostOffset = 0;
+    }
+    
+    if (hostLength != 0)
+    {
+        hostOffset += UART_BRIDGE_CDC(WriteBlock)(&hostBlock[hostOffset], hostLength - hostOffset);
+        if (hostOffset == hostLength)
+        {
+            if (hostLength == UART_BRIDGE_BLOCK_SIZE)
+            {
+                more = true;
+            }
+            hostLength = 0;
+        }
+    }
+    
+    UARTBridge_ReportErrors();
+    
+    return more;
+}
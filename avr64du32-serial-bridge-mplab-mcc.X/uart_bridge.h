@@ -0,0 +1,43 @@
+#ifndef UART_BRIDGE_H
+#define	UART_BRIDGE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Baud rate used until the host sends SET_LINE_CODING
+#define UART_BRIDGE_DEFAULT_BAUD 115200UL
+    
+//Bytes moved in each direction per call, 1 full-speed bulk packet
+#define UART_BRIDGE_BLOCK_SIZE 64
+
+//Received data is picked up at least this often, the receive interrupt posts no event
+#define UART_BRIDGE_PICKUP_MS 1
+
+    //Initializes the USART bridge
+    void UARTBridge_Initialize(void);
+
+    //Applies the CDC line coding to USART0 and starts forwarding data
+    //Returns false if the line coding isn't supported by the USART
+    bool UARTBridge_Start(void);
+
+    //Stops forwarding data and returns the CDC port to the text parser
+    //With the CDC data port enabled the bridge runs on the data port, and the text parser keeps the command port
+    void UARTBridge_Stop(void);
+
+    //Returns true while the bridge is running
+    bool UARTBridge_IsActive(void);
+
+    //Moves data between the CDC endpoints and USART0
+    //Returns true after a full block, more data may be waiting and the caller should run it again
+    bool UARTBridge_Handle(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* UART_BRIDGE_H */
+
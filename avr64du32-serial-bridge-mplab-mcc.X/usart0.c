@@ -0,0 +1,344 @@
+#include "usart0.h"
+
+#include <xc.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define USART0_RX_BUFFER_MASK (USART0_RX_BUFFER_SIZE - 1U)
+#define USART0_TX_BUFFER_MASK (USART0_TX_BUFFER_SIZE - 1U)
+
+//Received bytes, written by the receive interrupt
+static volatile uint8_t usart0RxHead = 0;
+static volatile uint8_t usart0RxTail = 0;
+static volatile uint8_t usart0RxBuffer[USART0_RX_BUFFER_SIZE];
+
+//Bytes to send, read by the data register empty interrupt
+static volatile uint8_t usart0TxHead = 0;
+static volatile uint8_t usart0TxTail = 0;
+static volatile uint8_t usart0TxBuffer[USART0_TX_BUFFER_SIZE];
+
+//USART0_ERROR_x_bm flags since the last USART0_ErrorGet
+static volatile uint8_t usart0Errors = 0;
+
+//Set once a frame has been sent, TXCIF is only meaningful after that
+static bool usart0TxStarted = false;
+
+//Initializes USART0 on PA0 (TxD) and PA1 (RxD) at 115200 baud, 8N1
+//The receiver and the transmitter stay off until USART0_Enable
+void USART0_Initialize(void)
+{
+    //TxD idles high, RxD is pulled up while nothing is connected
+    PORTA.OUTSET = PIN0_bm;
+    PORTA.DIRSET = PIN0_bm;
+    PORTA.PIN1CTRL = PORT_PULLUPEN_bm;
+
+    USART0.BAUD = USART0_BAUD_RATE(115200UL);
+
+    //Receive interrupt on, the data register empty interrupt is turned on by USART0_WriteBlock
+    USART0.CTRLA = USART_RXCIE_bm;
+
+    //Receiver and transmitter off, Normal mode
+    USART0.CTRLB = 0x00;
+
+    //Asynchronous, 8 data bits, no parity, 1 stop bit
+    USART0.CTRLC = (USART_CMODE_ASYNCHRONOUS_gc | USART_CHSIZE_8BIT_gc | USART_PMODE_DISABLED_gc | USART_SBMODE_1BIT_gc);
+
+    USART0.DBGCTRL = 0x00;
+    USART0.EVCTRL = 0x00;
+}
+
+//Receive complete, empties the receive FIFO (up to 2 bytes) into the ring buffer and records the errors
+//No function is called from here, so only the registers in use are saved
+ISR(USART0_RXC_vect)
+{
+    uint8_t head = usart0RxHead;
+    uint8_t nextHead;
+    uint8_t flags;
+    uint8_t data;
+
+    do
+    {
+        //RXDATAH has to be read before RXDATAL
+        flags = USART0.RXDATAH;
+        data = USART0.RXDATAL;
+        nextHead = (head + 1U) & USART0_RX_BUFFER_MASK;
+
+        if (flags & USART_PERR_bm)
+        {
+            usart0Errors |= USART0_ERROR_PARITY_bm;
+        }
+        if (flags & USART_FERR_bm)
+        {
+            usart0Errors |= USART0_ERROR_FRAMING_bm;
+        }
+
+        if (nextHead == usart0RxTail)
+        {
+            //Ring buffer full, the byte is dropped
+            usart0Errors |= USART0_ERROR_OVERRUN_bm;
+        }
+        else
+        {
+            usart0RxBuffer[head] = data;
+            head = nextHead;
+        }
+
+        if (flags & USART_BUFOVF_bm)
+        {
+            //Hardware FIFO overflow, a byte was lost before this one
+            usart0Errors |= USART0_ERROR_OVERRUN_bm;
+        }
+    } while (USART0.STATUS & USART_RXCIF_bm);
+
+    usart0RxHead = head;
+}
+
+//Data register empty, sends bytes of the transmit ring buffer while the data register has room
+//The first byte of a burst moves straight to the shift register, so a second one fits in the same interrupt
+ISR(USART0_DRE_vect)
+{
+    uint8_t tail = usart0TxTail;
+
+    while ((tail != usart0TxHead) && (USART0.STATUS & USART_DREIF_bm))
+    {
+        //TXCIF is cleared so USART0_IsTxDone() waits for this frame
+        USART0.STATUS = USART_TXCIF_bm;
+        USART0.TXDATAL = usart0TxBuffer[tail];
+        tail = (tail + 1U) & USART0_TX_BUFFER_MASK;
+    }
+
+    usart0TxTail = tail;
+
+    if (usart0TxHead == tail)
+    {
+        //Nothing left to send
+        USART0.CTRLA &= ~USART_DREIE_bm;
+    }
+}
+
+//Turns on the receiver and the transmitter
+void USART0_Enable(void)
+{
+    USART0.CTRLB |= (USART_RXEN_bm | USART_TXEN_bm);
+}
+
+//Turns off the receiver and the transmitter and empties both ring buffers
+void USART0_Disable(void)
+{
+    USART0.CTRLB &= ~(USART_RXEN_bm | USART_TXEN_bm);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        USART0.CTRLA &= ~USART_DREIE_bm;
+        usart0RxHead = 0;
+        usart0RxTail = 0;
+        usart0TxHead = 0;
+        usart0TxTail = 0;
+        usart0Errors = 0;
+    }
+    usart0TxStarted = false;
+}
+
+//Sets the baud rate, with double-speed mode if Normal mode can't reach it
+//Returns false if BAUD_RATE is out of range, the setting is then unchanged
+bool USART0_BaudRateSet(uint32_t baudRate)
+{
+    uint32_t baudValue;
+    uint8_t rxMode = USART_RXMODE_NORMAL_gc;
+
+    if (0UL == baudRate)
+    {
+        return false;
+    }
+
+    //Normal mode: BAUD = 64 * F_CPU / (16 * baud rate)
+    baudValue = ((4UL * F_CPU) + (baudRate / 2UL)) / baudRate;
+
+    if (baudValue < 64UL)
+    {
+        //Double-speed mode: BAUD = 64 * F_CPU / (8 * baud rate)
+        baudValue = ((8UL * F_CPU) + (baudRate / 2UL)) / baudRate;
+        rxMode = USART_RXMODE_CLK2X_gc;
+    }
+
+    if ((baudValue < 64UL) || (baudValue > 0xFFFFUL))
+    {
+        return false;
+    }
+
+    USART0.BAUD = (uint16_t)baudValue;
+    USART0.CTRLB = (USART0.CTRLB & ~USART_RXMODE_gm) | rxMode;
+    return true;
+}
+
+//Sets the parity, returns false for mark and space parity (not supported by the hardware)
+bool USART0_ParityModeSet(uart_parity_t parity)
+{
+    uint8_t parityMode;
+
+    switch (parity)
+    {
+        case UART_PARITY_NONE:
+        {
+            parityMode = USART_PMODE_DISABLED_gc;
+            break;
+        }
+        case UART_PARITY_ODD:
+        {
+            parityMode = USART_PMODE_ODD_gc;
+            break;
+        }
+        case UART_PARITY_EVEN:
+        {
+            parityMode = USART_PMODE_EVEN_gc;
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    USART0.CTRLC = (USART0.CTRLC & ~USART_PMODE_gm) | parityMode;
+    return true;
+}
+
+//Sets the number of stop bits, 1.5 stop bits are sent as 2
+void USART0_StopBitsSet(uart_stop_bits_t stopBits)
+{
+    if (UART_STOP_BITS_1 == stopBits)
+    {
+        USART0.CTRLC &= ~USART_SBMODE_bm;
+    }
+    else
+    {
+        USART0.CTRLC |= USART_SBMODE_bm;
+    }
+}
+
+//Sets the number of data bits, returns false for 9-bit frames (not supported by the ring buffers)
+bool USART0_CharacterSizeSet(uart_data_bits_t dataBits)
+{
+    uint8_t charSize;
+
+    switch (dataBits)
+    {
+        case UART_DATA_5_BITS:
+        {
+            charSize = USART_CHSIZE_5BIT_gc;
+            break;
+        }
+        case UART_DATA_6_BITS:
+        {
+            charSize = USART_CHSIZE_6BIT_gc;
+            break;
+        }
+        case UART_DATA_7_BITS:
+        {
+            charSize = USART_CHSIZE_7BIT_gc;
+            break;
+        }
+        case UART_DATA_8_BITS:
+        {
+            charSize = USART_CHSIZE_8BIT_gc;
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    USART0.CTRLC = (USART0.CTRLC & ~USART_CHSIZE_gm) | charSize;
+    return true;
+}
+
+//Returns the number of bytes in the receive ring buffer
+uint8_t USART0_RxCountGet(void)
+{
+    return (usart0RxHead - usart0RxTail) & USART0_RX_BUFFER_MASK;
+}
+
+//Returns the free space in the transmit ring buffer
+uint8_t USART0_TxFreeGet(void)
+{
+    return USART0_TX_BUFFER_MASK - ((usart0TxHead - usart0TxTail) & USART0_TX_BUFFER_MASK);
+}
+
+//Returns true once the transmit ring buffer is empty and the last frame has been shifted out
+bool USART0_IsTxDone(void)
+{
+    if ((usart0TxHead != usart0TxTail) || (USART0.CTRLA & USART_DREIE_bm))
+    {
+        return false;
+    }
+
+    //TXCIF is cleared before each frame, and is set once the last one has been shifted out
+    return (!usart0TxStarted) || (USART0.STATUS & USART_TXCIF_bm);
+}
+
+//Returns and clears the USART0_ERROR_x_bm flags seen by the receiver since the last call
+uint8_t USART0_ErrorGet(void)
+{
+    uint8_t errors;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        errors = usart0Errors;
+        usart0Errors = 0;
+    }
+
+    return errors;
+}
+
+//Copies up to MAX_LENGTH bytes out of the receive ring buffer, returns the number of bytes copied
+uint8_t USART0_ReadBlock(uint8_t* data, uint8_t maxLength)
+{
+    uint8_t count = 0;
+    uint8_t tail = usart0RxTail;
+
+    while ((count < maxLength) && (tail != usart0RxHead))
+    {
+        data[count] = usart0RxBuffer[tail];
+        tail = (tail + 1U) & USART0_RX_BUFFER_MASK;
+        count++;
+    }
+
+    //Single update of the tail for the whole block
+    usart0RxTail = tail;
+    return count;
+}
+
+//Queues as much of DATA as fits in the transmit ring buffer, returns the number of bytes queued
+uint8_t USART0_WriteBlock(const uint8_t* data, uint8_t length)
+{
+    uint8_t count = 0;
+    uint8_t head = usart0TxHead;
+    uint8_t nextHead;
+
+    while (count < length)
+    {
+        nextHead = (head + 1U) & USART0_TX_BUFFER_MASK;
+        if (nextHead == usart0TxTail)
+        {
+            break;
+        }
+
+        usart0TxBuffer[head] = data[count];
+        head = nextHead;
+        count++;
+    }
+
+    if (0U != count)
+    {
+        //Publish the block, then start the data register empty interrupt
+        usart0TxHead = head;
+        usart0TxStarted = true;
+        USART0.CTRLA |= USART_DREIE_bm;
+    }
+
+    return count;
+}
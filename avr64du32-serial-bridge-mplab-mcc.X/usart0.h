@@ -0,0 +1,95 @@
+#ifndef USART0_H
+#define	USART0_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mcc_generated_files/system/clock.h"
+
+//Size of each ring buffer, a power of two no larger than 256
+#define USART0_RX_BUFFER_SIZE 256U
+#define USART0_TX_BUFFER_SIZE 256U
+
+//Converts a baud rate to a BAUD register value in Normal mode
+#define USART0_BAUD_RATE(BAUD_RATE) ((uint16_t) (((4UL * F_CPU) + ((BAUD_RATE) / 2UL)) / (BAUD_RATE)))
+
+//Error flags returned by USART0_ErrorGet
+#define USART0_ERROR_PARITY_bm 0x01U
+#define USART0_ERROR_FRAMING_bm 0x02U
+#define USART0_ERROR_OVERRUN_bm 0x04U
+
+    //Parity modes of the UART frame, in the order of the CDC line coding
+    typedef enum {
+        UART_PARITY_NONE = 0,
+        UART_PARITY_ODD,
+        UART_PARITY_EVEN,
+        UART_PARITY_MARK,
+        UART_PARITY_SPACE
+    } uart_parity_t;
+
+    //Stop bits of the UART frame, in the order of the CDC line coding
+    typedef enum {
+        UART_STOP_BITS_1 = 0,
+        UART_STOP_BITS_1_5,
+        UART_STOP_BITS_2
+    } uart_stop_bits_t;
+
+    //Data bits of the UART frame
+    typedef enum {
+        UART_DATA_5_BITS = 0,
+        UART_DATA_6_BITS,
+        UART_DATA_7_BITS,
+        UART_DATA_8_BITS,
+        UART_DATA_9_BITS
+    } uart_data_bits_t;
+
+    //Initializes USART0 on PA0 (TxD) and PA1 (RxD) at 115200 baud, 8N1
+    //The receiver and the transmitter stay off until USART0_Enable
+    void USART0_Initialize(void);
+
+    //Turns on the receiver and the transmitter
+    void USART0_Enable(void);
+
+    //Turns off the receiver and the transmitter and empties both ring buffers
+    void USART0_Disable(void);
+
+    //Sets the baud rate, with double-speed mode if Normal mode can't reach it
+    //Returns false if BAUD_RATE is out of range, the setting is then unchanged
+    bool USART0_BaudRateSet(uint32_t baudRate);
+
+    //Sets the parity, returns false for mark and space parity (not supported by the hardware)
+    bool USART0_ParityModeSet(uart_parity_t parity);
+
+    //Sets the number of stop bits, 1.5 stop bits are sent as 2
+    void USART0_StopBitsSet(uart_stop_bits_t stopBits);
+
+    //Sets the number of data bits, returns false for 9-bit frames (not supported by the ring buffers)
+    bool USART0_CharacterSizeSet(uart_data_bits_t dataBits);
+
+    //Returns the number of bytes in the receive ring buffer
+    uint8_t USART0_RxCountGet(void);
+
+    //Returns the free space in the transmit ring buffer
+    uint8_t USART0_TxFreeGet(void);
+
+    //Returns true once the transmit ring buffer is empty and the last frame has been shifted out
+    bool USART0_IsTxDone(void);
+
+    //Returns and clears the USART0_ERROR_x_bm flags seen by the receiver since the last call
+    uint8_t USART0_ErrorGet(void);
+
+    //Copies up to MAX_LENGTH bytes out of the receive ring buffer, returns the number of bytes copied
+    uint8_t USART0_ReadBlock(uint8_t* data, uint8_t maxLength);
+
+    //Queues as much of DATA as fits in the transmit ring buffer, returns the number of bytes queued
+    uint8_t USART0_WriteBlock(const uint8_t* data, uint8_t length);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* USART0_H */
+
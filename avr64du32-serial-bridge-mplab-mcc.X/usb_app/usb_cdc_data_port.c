@@ -0,0 +1,299 @@
+/**
+ * USBCDCDATAPORT CDC Data Port Source File
+ * @file usb_cdc_data_port.c
+ * @ingroup usb_cdc
+ * @brief This file contains the implementation of the second CDC function, used for streamed data
+ */
+
+#include <usb_cdc_data_port.h>
+#include <usb_cdc.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <usb_config.h>
+#include <circular_buffer.h>
+
+// USB Pipes
+STATIC USB_PIPE_t CDCDataPortTxPipe = {
+    .address = USB_CDC_DATA_PORT_BULK_EP_IN,
+    .direction = USB_EP_DIR_IN,
+};
+
+STATIC USB_PIPE_t CDCDataPortRxPipe = {
+    .address = USB_CDC_DATA_PORT_BULK_EP_OUT,
+    .direction = USB_EP_DIR_OUT,
+};
+
+STATIC USB_PIPE_t CDCDataPortNotificationPipe = {
+    .address = USB_CDC_DATA_PORT_INTERRUPT_EP,
+    .direction = USB_EP_DIR_IN,
+};
+
+// SERIAL_STATE notification
+STATIC USB_CDC_SERIAL_STATE_NOTIFICATION_t usbCDCDataPortSerialStateNotification __attribute__((aligned(2))) = {
+    .header = {
+        .bmRequestType = USB_CDC_NOTIFICATION_REQUEST_TYPE,
+        .bNotification = USB_CDC_NOTIFICATION_SERIAL_STATE,
+        .wValue = 0,
+        .wIndex = USB_CDC_DATA_PORT_COMM_INTERFACE,
+        .wLength = sizeof(uint16_t),
+    },
+    .bmUartState = 0,
+};
+STATIC volatile uint16_t usbCDCDataPortSerialState;
+STATIC volatile bool usbCDCDataPortSerialStatePending;
+
+// Received bytes dropped because the receive buffer was full
+STATIC uint32_t usbCDCDataPortReceiveDropped = 0;
+
+// RX Buffer
+STATIC uint8_t usbCDCDataPortReceiveTempBuffer[USB_CDC_DATA_PORT_RX_PACKET_SIZE] __attribute__((aligned(2)));
+STATIC uint8_t usbCDCDataPortReceiveArray[USB_CDC_DATA_PORT_RX_BUFFER_SIZE];
+STATIC CIRCULAR_BUFFER_t usbCDCDataPortReceiveBuffer = {
+    .content = usbCDCDataPortReceiveArray,
+    .head = 0,
+    .tail = 0,
+    .maxLength = USB_CDC_DATA_PORT_RX_BUFFER_SIZE,
+};
+// TX Buffer, data is staged out of the circular buffer so it can be refilled during a transfer
+STATIC uint8_t usbCDCDataPortTransmitStage[USB_CDC_DATA_PORT_TX_BUFFER_SIZE] __attribute__((aligned(2)));
+STATIC uint8_t usbCDCDataPortTransmitArray[USB_CDC_DATA_PORT_TX_BUFFER_SIZE];
+STATIC CIRCULAR_BUFFER_t usbCDCDataPortTransmitBuffer = {
+    .content = usbCDCDataPortTransmitArray,
+    .head = 0,
+    .tail = 0,
+    .maxLength = USB_CDC_DATA_PORT_TX_BUFFER_SIZE,
+};
+
+void USB_CDCDataPortInitialize(void)
+{
+    usbCDCDataPortSerialState = 0;
+    usbCDCDataPortSerialStatePending = false;
+}
+
+STATIC RETURN_CODE_t USB_CDCDataPortTransmitHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+    uint16_t length = 0;
+
+    // Checks if data have been added to transmit buffer
+    if (false == CIRCBUF_Empty(&usbCDCDataPortTransmitBuffer))
+    {
+        // Transmits data to host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(CDCDataPortTxPipe))
+        {
+            // Moves the data to the stage, the circular buffer is free for new data during the transfer
+            while ((length < USB_CDC_DATA_PORT_TX_BUFFER_SIZE) && (BUFFER_SUCCESS == CIRCBUF_Dequeue(&usbCDCDataPortTransmitBuffer, &usbCDCDataPortTransmitStage[length])))
+            {
+                length++;
+            }
+
+            status = USB_TransferWriteStart(CDCDataPortTxPipe, usbCDCDataPortTransmitStage, length, true, USB_CDCDataPortDataTransmitted);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // No data to transmit
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_CDCDataPortNotificationHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if the UART state changed since the last notification
+    if (true == usbCDCDataPortSerialStatePending)
+    {
+        // Sends the notification if the previous one has been read by the host
+        if (false == USB_PipeStatusIsBusy(CDCDataPortNotificationPipe))
+        {
+            usbCDCDataPortSerialStatePending = false;
+            usbCDCDataPortSerialStateNotification.bmUartState = usbCDCDataPortSerialState;
+
+            status = USB_TransferWriteStart(CDCDataPortNotificationPipe, (uint8_t *)&usbCDCDataPortSerialStateNotification, sizeof(USB_CDC_SERIAL_STATE_NOTIFICATION_t), false, USB_CDCDataPortNotificationTransmitted);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // No notification to send
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_CDCDataPortReceiveHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if room exist for 1 USB CDC packet in the receive buffer
+    if (USB_CDC_DATA_PORT_RX_PACKET_SIZE <= CIRCBUF_FreeSpace(&usbCDCDataPortReceiveBuffer))
+    {
+        // Receives data from host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(CDCDataPortRxPipe))
+        {
+            status = USB_TransferReadStart(CDCDataPortRxPipe, usbCDCDataPortReceiveTempBuffer, USB_CDC_DATA_PORT_RX_PACKET_SIZE, false, USB_CDCDataPortDataReceived);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // RX buffer is full, retry on next iteration
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_CDCDataPortHandler(void)
+{
+    RETURN_CODE_t status;
+    RETURN_CODE_t stepStatus;
+
+    // Each direction runs on its own, an error on one does not stall the others
+    status = USB_CDCDataPortTransmitHandler();
+
+    stepStatus = USB_CDCDataPortNotificationHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+
+    stepStatus = USB_CDCDataPortReceiveHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+
+    return status;
+}
+
+uint16_t USB_CDCDataPortReadBlock(uint8_t *data, uint16_t maxLength)
+{
+    uint16_t count = 0;
+
+    while ((count < maxLength) && (BUFFER_SUCCESS == CIRCBUF_Dequeue(&usbCDCDataPortReceiveBuffer, &data[count])))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+uint16_t USB_CDCDataPortWriteBlock(const uint8_t *data, uint16_t length)
+{
+    uint16_t count = 0;
+
+    while ((count < length) && (BUFFER_SUCCESS == CIRCBUF_Enqueue(&usbCDCDataPortTransmitBuffer, data[count])))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+uint32_t USB_CDCDataPortReceiveDroppedGet(void)
+{
+    return usbCDCDataPortReceiveDropped;
+}
+
+RETURN_CODE_t USB_CDCDataPortPipesReset(void)
+{
+    // Buffered data is kept, the handler restarts the transfers on the next call
+    RETURN_CODE_t status = USB_TransferAbort(CDCDataPortTxPipe);
+    RETURN_CODE_t pipeStatus;
+
+    pipeStatus = USB_TransferAbort(CDCDataPortRxPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+    pipeStatus = USB_TransferAbort(CDCDataPortNotificationPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+    return status;
+}
+
+void USB_CDCDataPortSerialStateSet(uint16_t state)
+{
+    uint16_t newState = (usbCDCDataPortSerialState & ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm) | (state & USB_CDC_SERIAL_STATE_CONTINUOUS_gm);
+
+    if (newState != usbCDCDataPortSerialState)
+    {
+        usbCDCDataPortSerialState = newState;
+        usbCDCDataPortSerialStatePending = true;
+    }
+}
+
+void USB_CDCDataPortSerialStateEvent(uint16_t events)
+{
+    events &= ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm;
+
+    if (0U != events)
+    {
+        usbCDCDataPortSerialState |= events;
+        usbCDCDataPortSerialStatePending = true;
+    }
+}
+
+void USB_CDCDataPortNotificationTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+    (void)(bytesTransferred);
+
+    if (USB_PIPE_TRANSFER_OK != status)
+    {
+        // Notification lost, send the current state again, events included
+        usbCDCDataPortSerialStatePending = true;
+    }
+    else
+    {
+        // Events are only reported once, events raised since the notification was started are kept
+        usbCDCDataPortSerialState &= ~(usbCDCDataPortSerialStateNotification.bmUartState & ~USB_CDC_SERIAL_STATE_CONTINUOUS_gm);
+    }
+}
+
+void USB_CDCDataPortDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+
+    if (USB_PIPE_TRANSFER_OK == status)
+    {
+        // Moves received data to circular buffer, the data port has no echo
+        for (uint16_t i = 0; i < bytesTransferred; i++)
+        {
+            if (BUFFER_SUCCESS != CIRCBUF_Enqueue(&usbCDCDataPortReceiveBuffer, usbCDCDataPortReceiveTempBuffer[i]))
+            {
+                // Receive buffer full, the byte is dropped
+                usbCDCDataPortReceiveDropped++;
+            }
+        }
+    }
+    else
+    {
+        ; // Transfer error, do nothing in callback
+    }
+}
+
+void USB_CDCDataPortDataTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+    (void)(status);
+    (void)(bytesTransferred);
+
+    // The stage is free again, data added during the transfer is sent on the next call of the handler
+}
@@ -0,0 +1,115 @@
+/**
+ * USBCDCDATAPORT CDC Data Port Header File
+ * @file usb_cdc_data_port.h
+ * @ingroup usb_cdc
+ * @brief This file contains prototypes for the second CDC function, used for streamed data
+ */
+
+#ifndef USB_CDC_DATA_PORT_H
+#define USB_CDC_DATA_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <usb_core.h>
+#include <usb_common_elements.h>
+#include <usb_protocol_cdc.h>
+
+/**
+ * @ingroup usb_cdc
+ * @brief Initializes the CDC data port. The line coding and line state are initialized with the command port.
+ * @param None.
+ * @return None.
+ */
+void USB_CDCDataPortInitialize(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Starts the transfers of the CDC data port.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_CDCDataPortHandler(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Pulls up to maxLength bytes from the data port receive buffer.
+ * @param data - Pointer to application receive buffer
+ * @param maxLength - Size of the application receive buffer
+ * @return Number of bytes copied to data
+ */
+uint16_t USB_CDCDataPortReadBlock(uint8_t *data, uint16_t maxLength);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Adds as much of a block of data as fits to the data port transmit buffer.
+ * @param data - Pointer to data to be transmitted
+ * @param length - Length in number of bytes for data to be transmitted
+ * @return Number of bytes added to the transmit buffer
+ */
+uint16_t USB_CDCDataPortWriteBlock(const uint8_t *data, uint16_t length);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Returns the number of received bytes dropped because the data port receive buffer was full.
+ * @param None.
+ * @return Dropped bytes since startup, wraps around after 2^32
+ */
+uint32_t USB_CDCDataPortReceiveDroppedGet(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Aborts the transfers on the data port data and notification pipes, buffered data is kept.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_CDCDataPortPipesReset(void);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Sets the continuous part of the UART state (DCD and DSR) reported by the data port.
+ *        A notification is sent on the interrupt endpoint if the state changed.
+ * @param state - Bitmap of USB_CDC_SERIAL_STATE_RX_CARRIER_bm and USB_CDC_SERIAL_STATE_TX_CARRIER_bm
+ * @return None.
+ */
+void USB_CDCDataPortSerialStateSet(uint16_t state);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Reports UART state events with a SERIAL_STATE notification of the data port.
+ *        Events are cleared once the host has read the notification, a failed notification is sent again.
+ * @param events - Bitmap of USB_CDC_SERIAL_STATE_t event bits
+ * @return None.
+ */
+void USB_CDCDataPortSerialStateEvent(uint16_t events);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Callback function called after the SERIAL_STATE notification of the data port is sent.
+ * @param pipe - USB pipe used for the started transaction
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes transmitted in the transaction
+ * @return None.
+ */
+void USB_CDCDataPortNotificationTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Callback function called after a data port IN transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes transmitted in the transfer
+ * @return None.
+ */
+void USB_CDCDataPortDataTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+/**
+ * @ingroup usb_cdc
+ * @brief Callback function called after a data port OUT transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes received in the transfer
+ * @return None.
+ */
+void USB_CDCDataPortDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+#endif /* USB_CDC_DATA_PORT_H */
@@ -0,0 +1,57 @@
+/**
+ * USBFUNCTIONS Application USB Functions Source File
+ * @file usb_functions.c
+ * @ingroup usb_functions
+ * @brief This file contains the setup of the USB functions added to the generated CDC port
+ */
+
+#include <usb_functions.h>
+#include <usb_core.h>
+#include <usb_config.h>
+#include <usb_descriptors.h>
+#if USB_VENDOR_ENABLE
+#include <usb_vendor.h>
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+#include <usb_cdc_data_port.h>
+#endif
+#if USB_HID_ENABLE
+#include <usb_cdc.h>
+#include <usb_hid.h>
+
+static RETURN_CODE_t USBFunctions_ClassRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr);
+#endif
+
+void USBFunctions_Initialize(void)
+{
+#if USB_CDC_DATA_PORT_ENABLE
+    USB_CDCDataPortInitialize();
+#endif
+#if USB_VENDOR_ENABLE
+    USB_VendorInitialize((uint8_t *) & msOS20DescriptorSet, sizeof (msOS20DescriptorSet));
+#endif
+#if USB_HID_ENABLE
+    USB_HIDInitialize(hidDescriptorPtr, hidReportDescriptor, sizeof (hidReportDescriptor));
+
+    // Replaces the CDC class request handler, requests are routed by interface
+    USB_ClassRequestCallbackRegister(USBFunctions_ClassRequestHandler);
+#endif
+}
+
+#if USB_HID_ENABLE
+static RETURN_CODE_t USBFunctions_ClassRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
+{
+    RETURN_CODE_t status;
+
+    if ((USB_REQUEST_RECIPIENT_INTERFACE == setupRequestPtr->bmRequestType.recipient) && (USB_HID_INTERFACE == (setupRequestPtr->wIndex & 0xFFU)))
+    {
+        status = USB_HIDRequestHandler(setupRequestPtr);
+    }
+    else
+    {
+        status = USB_CDCRequestHandler(setupRequestPtr);
+    }
+
+    return status;
+}
+#endif
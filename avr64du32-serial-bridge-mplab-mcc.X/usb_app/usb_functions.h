@@ -0,0 +1,21 @@
+/**
+ * USBFUNCTIONS Application USB Functions Header File
+ * @file usb_functions.h
+ * @defgroup usb_functions USB Application Functions
+ * @brief This file contains the prototype that sets up the USB functions added to the generated CDC port
+ */
+
+#ifndef USB_FUNCTIONS_H
+#define USB_FUNCTIONS_H
+
+/**
+ * @ingroup usb_functions
+ * @brief Initializes the CDC data port, vendor and HID interfaces that are enabled in usb_config.h.
+ * With HID enabled, class requests are routed to the HID or CDC handler by interface.
+ * Runs after SYSTEM_Initialize, which sets up the CDC command port.
+ * @param None.
+ * @return None.
+ */
+void USBFunctions_Initialize(void);
+
+#endif // USB_FUNCTIONS_H
@@ -0,0 +1,295 @@
+/**
+ * USBHID HID Interface Source File
+ * @file usb_hid.c
+ * @ingroup usb_hid
+ * @brief This file contains the implementation of the HID interface with one input and one output report
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <usb_hid.h>
+#include <usb_core.h>
+#include <usb_core_transfer.h>
+#include <usb_protocol_headers.h>
+#include <usb_config.h>
+
+// HID and report descriptors, read with Get_Descriptor on the interface
+STATIC USB_HID_DESCRIPTOR_t *usbHIDDescriptorPtr = NULL;
+STATIC uint8_t *usbHIDReportDescriptorPtr = NULL;
+STATIC uint16_t usbHIDReportDescriptorLength = 0;
+
+// USB Pipes
+STATIC USB_PIPE_t HIDTxPipe = {
+    .address = USB_HID_INTERRUPT_EP_IN,
+    .direction = USB_EP_DIR_IN,
+};
+
+STATIC USB_PIPE_t HIDRxPipe = {
+    .address = USB_HID_INTERRUPT_EP_OUT,
+    .direction = USB_EP_DIR_OUT,
+};
+
+// One report each way, the host is NAKed until the application has read the output report
+STATIC uint8_t usbHIDOutputReport[USB_HID_REPORT_SIZE];
+STATIC uint8_t usbHIDInputReport[USB_HID_REPORT_SIZE];
+STATIC bool usbHIDOutputReportFull;
+STATIC bool usbHIDInputReportFull;
+
+// Idle rate set by the host, reports are only sent as responses so it is not used
+STATIC uint8_t usbHIDIdleRate;
+
+STATIC void USB_HIDReportsReset(void)
+{
+    usbHIDOutputReportFull = false;
+    usbHIDInputReportFull = false;
+}
+
+void USB_HIDInitialize(USB_HID_DESCRIPTOR_t *hidDescriptorPtr, uint8_t *reportDescriptorPtr, uint16_t reportDescriptorLength)
+{
+    usbHIDDescriptorPtr = hidDescriptorPtr;
+    usbHIDReportDescriptorPtr = reportDescriptorPtr;
+    usbHIDReportDescriptorLength = reportDescriptorLength;
+    usbHIDIdleRate = 0;
+
+    for (uint8_t i = 0; i < USB_HID_REPORT_SIZE; i++)
+    {
+        usbHIDInputReport[i] = 0;
+    }
+
+    USB_HIDReportsReset();
+}
+
+STATIC RETURN_CODE_t USB_HIDDescriptorGet(USB_SETUP_REQUEST_t *setupRequestPtr)
+{
+    RETURN_CODE_t status = UNSUPPORTED;
+    uint8_t *dataPtr = NULL;
+    uint16_t length = 0;
+
+    switch ((uint8_t)(setupRequestPtr->wValue >> 8u))
+    {
+    case USB_HID_DESCRIPTOR_TYPE_HID:
+        dataPtr = (uint8_t *)usbHIDDescriptorPtr;
+        length = sizeof(USB_HID_DESCRIPTOR_t);
+        break;
+    case USB_HID_DESCRIPTOR_TYPE_REPORT:
+        dataPtr = usbHIDReportDescriptorPtr;
+        length = usbHIDReportDescriptorLength;
+        break;
+    default:
+        ; // No physical descriptors
+        break;
+    }
+
+    if (NULL != dataPtr)
+    {
+        if (length > setupRequestPtr->wLength)
+        {
+            length = setupRequestPtr->wLength;
+        }
+        status = USB_TransferControlDataSet(dataPtr, length, NULL);
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_HIDRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
+{
+    RETURN_CODE_t status = UNSUPPORTED;
+    uint16_t length;
+
+    if (USB_REQUEST_RECIPIENT_INTERFACE != (USB_REQUEST_RECIPIENT_t)setupRequestPtr->bmRequestType.recipient)
+    {
+        ; // HID requests are sent to the interface
+    }
+    else if (USB_REQUEST_TYPE_STANDARD == (USB_REQUEST_TYPE_t)setupRequestPtr->bmRequestType.type)
+    {
+        // Standard requests reach the class handler only for class descriptors
+        if (USB_REQUEST_GET_DESCRIPTOR == setupRequestPtr->bRequest)
+        {
+            status = USB_HIDDescriptorGet(setupRequestPtr);
+        }
+    }
+    else if (USB_REQUEST_TYPE_CLASS == (USB_REQUEST_TYPE_t)setupRequestPtr->bmRequestType.type)
+    {
+        switch (setupRequestPtr->bRequest)
+        {
+        case USB_HID_REQUEST_GET_REPORT:
+            // Returns the last input report, the output report is only sent on the interrupt endpoint
+            if (USB_HID_REPORT_TYPE_INPUT == (uint8_t)(setupRequestPtr->wValue >> 8u))
+            {
+                length = USB_HID_REPORT_SIZE;
+                if (length > setupRequestPtr->wLength)
+                {
+                    length = setupRequestPtr->wLength;
+                }
+                status = USB_TransferControlDataSet(usbHIDInputReport, length, NULL);
+            }
+            break;
+        case USB_HID_REQUEST_GET_IDLE:
+            status = USB_TransferControlDataSet(&usbHIDIdleRate, sizeof(usbHIDIdleRate), NULL);
+            break;
+        case USB_HID_REQUEST_SET_IDLE:
+            usbHIDIdleRate = (uint8_t)(setupRequestPtr->wValue >> 8u);
+            status = SUCCESS;
+            break;
+        default:
+            status = UNSUPPORTED; // Set_Report and the boot protocol requests are not supported
+            break;
+        }
+    }
+    else
+    {
+        ; // Unsupported or invalid request type
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_HIDReceiveHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if the last output report was read
+    if (false == usbHIDOutputReportFull)
+    {
+        // Receives data from host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(HIDRxPipe))
+        {
+            status = USB_TransferReadStart(HIDRxPipe, usbHIDOutputReport, USB_HID_REPORT_SIZE, false, USB_HIDOutputReportReceived);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // The application has not read the last report, the host is NAKed until it does
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_HIDTransmitHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if an input report is queued
+    if (true == usbHIDInputReportFull)
+    {
+        // Transmits data to host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(HIDTxPipe))
+        {
+            status = USB_TransferWriteStart(HIDTxPipe, usbHIDInputReport, USB_HID_REPORT_SIZE, false, USB_HIDInputReportTransmitted);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // No data to transmit
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_HIDHandler(void)
+{
+    RETURN_CODE_t status;
+    RETURN_CODE_t stepStatus;
+
+    // Each direction runs on its own, an error on one does not stall the other
+    status = USB_HIDTransmitHandler();
+
+    stepStatus = USB_HIDReceiveHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+
+    return status;
+}
+
+RETURN_CODE_t USB_HIDPipesReset(void)
+{
+    RETURN_CODE_t status = USB_TransferAbort(HIDTxPipe);
+    RETURN_CODE_t pipeStatus;
+
+    pipeStatus = USB_TransferAbort(HIDRxPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+    // The host repeats a request that got no response
+    USB_HIDReportsReset();
+
+    return status;
+}
+
+bool USB_HIDOutputReportRead(uint8_t *reportPtr)
+{
+    bool isRead = false;
+
+    if (true == usbHIDOutputReportFull)
+    {
+        for (uint8_t i = 0; i < USB_HID_REPORT_SIZE; i++)
+        {
+            reportPtr[i] = usbHIDOutputReport[i];
+        }
+        usbHIDOutputReportFull = false;
+        isRead = true;
+    }
+
+    return isRead;
+}
+
+bool USB_HIDInputReportWrite(const uint8_t *reportPtr)
+{
+    bool isQueued = false;
+
+    // The buffer is sent as it is, so it is only written while no transfer uses it
+    if ((false == usbHIDInputReportFull) && (false == USB_PipeStatusIsBusy(HIDTxPipe)))
+    {
+        for (uint8_t i = 0; i < USB_HID_REPORT_SIZE; i++)
+        {
+            usbHIDInputReport[i] = reportPtr[i];
+        }
+        usbHIDInputReportFull = true;
+        isQueued = true;
+    }
+
+    return isQueued;
+}
+
+bool USB_HIDInputReportIsFree(void)
+{
+    return ((false == usbHIDInputReportFull) && (false == USB_PipeStatusIsBusy(HIDTxPipe)));
+}
+
+void USB_HIDOutputReportReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+
+    if (USB_PIPE_TRANSFER_OK == status)
+    {
+        // Short reports are padded with the rest of the last one, the report format has its own length field
+        usbHIDOutputReportFull = (0U != bytesTransferred);
+    }
+    else
+    {
+        ; // Transfer aborted, the buffer stays free
+    }
+}
+
+void USB_HIDInputReportTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+    (void)(status);
+    (void)(bytesTransferred);
+
+    // Sent or aborted by a reset, the buffer is free for the next report either way
+    usbHIDInputReportFull = false;
+}
@@ -0,0 +1,97 @@
+/**
+ * USBHID HID Interface Header File
+ * @file usb_hid.h
+ * @defgroup usb_hid USB Human Interface Device Interface
+ * @brief This file contains prototypes and data types for the HID interface with one input and one output report
+ */
+
+#ifndef USB_HID_H
+#define USB_HID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <usb_core.h>
+#include <usb_common_elements.h>
+#include <usb_protocol_hid.h>
+#include <usb_config.h>
+
+/**
+ * @ingroup usb_hid
+ * @brief Initializes the HID interface.
+ * @param hidDescriptorPtr - Pointer to the HID descriptor in the configuration descriptor
+ * @param reportDescriptorPtr - Pointer to the report descriptor
+ * @param reportDescriptorLength - Size of the report descriptor in bytes
+ * @return None.
+ */
+void USB_HIDInitialize(USB_HID_DESCRIPTOR_t *hidDescriptorPtr, uint8_t *reportDescriptorPtr, uint16_t reportDescriptorLength);
+
+/**
+ * @ingroup usb_hid
+ * @brief Performs handling of the HID class requests, and of the Get_Descriptor requests for the HID and report descriptors.
+ * @param setupRequestPtr - Pointer to the Setup Request struct
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_HIDRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr);
+
+/**
+ * @ingroup usb_hid
+ * @brief Starts the interrupt transfers, receives the next output report once the last one was read
+ * and sends the queued input report.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_HIDHandler(void);
+
+/**
+ * @ingroup usb_hid
+ * @brief Aborts the transfers on the HID interrupt pipes, queued reports are dropped.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_HIDPipesReset(void);
+
+/**
+ * @ingroup usb_hid
+ * @brief Copies the last output report received from the host, and frees the buffer for the next one.
+ * @param reportPtr - Buffer of USB_HID_REPORT_SIZE bytes
+ * @return true if a report was copied, false if none was received
+ */
+bool USB_HIDOutputReportRead(uint8_t *reportPtr);
+
+/**
+ * @ingroup usb_hid
+ * @brief Queues an input report, sent on the next poll of the host after USB_HIDHandler runs.
+ * @param reportPtr - Report of USB_HID_REPORT_SIZE bytes
+ * @return true if the report was queued, false if the last one was not sent yet
+ */
+bool USB_HIDInputReportWrite(const uint8_t *reportPtr);
+
+/**
+ * @ingroup usb_hid
+ * @brief Checks if an input report can be queued.
+ * @param None.
+ * @return true if the last input report was sent, false otherwise
+ */
+bool USB_HIDInputReportIsFree(void);
+
+/**
+ * @ingroup usb_hid
+ * @brief Callback function called after an interrupt OUT transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes received in the transfer
+ * @return None.
+ */
+void USB_HIDOutputReportReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+/**
+ * @ingroup usb_hid
+ * @brief Callback function called after an interrupt IN transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes transmitted in the transfer
+ * @return None.
+ */
+void USB_HIDInputReportTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+#endif /* USB_HID_H */
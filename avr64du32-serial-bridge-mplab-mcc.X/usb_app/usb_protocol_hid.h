@@ -0,0 +1,96 @@
+/**
+ * USBPROTOCOLHID HID Protocol Header File
+ * @file usb_protocol_hid.h
+ * @ingroup usb_hid
+ * @brief USB Human Interface Device class descriptor and request definitions
+ */
+
+#ifndef USB_PROTOCOL_HID_H
+#define USB_PROTOCOL_HID_H
+
+#include <stdint.h>
+#include <usb_protocol_headers.h>
+
+/**
+ * @ingroup usb_hid
+ * @def USB_HID_INTERFACE_CLASS
+ * @brief Interface class code of a HID interface.
+ */
+#define USB_HID_INTERFACE_CLASS 0x03U
+
+/**
+ * @ingroup usb_hid
+ * @def USB_HID_NO_SUBCLASS
+ * @brief Interface subclass code of a HID interface without boot protocol.
+ */
+#define USB_HID_NO_SUBCLASS 0x00U
+
+/**
+ * @ingroup usb_hid
+ * @def USB_HID_NO_PROTOCOL
+ * @brief Interface protocol code of a HID interface without boot protocol.
+ */
+#define USB_HID_NO_PROTOCOL 0x00U
+
+/**
+ * @ingroup usb_hid
+ * @def USB_HID_BCD_VERSION
+ * @brief bcdHID of the HID specification version 1.11.
+ */
+#define USB_HID_BCD_VERSION 0x0111U
+
+/**
+ * @ingroup usb_hid
+ * @enum USB_HID_DESCRIPTOR_TYPE_t
+ * @brief Type define for the HID class descriptor types.
+ */
+typedef enum USB_HID_DESCRIPTOR_TYPE_enum
+{
+    USB_HID_DESCRIPTOR_TYPE_HID = 0x21,      /**<HID descriptor, follows the interface descriptor*/
+    USB_HID_DESCRIPTOR_TYPE_REPORT = 0x22,   /**<Report descriptor, only read with Get_Descriptor*/
+    USB_HID_DESCRIPTOR_TYPE_PHYSICAL = 0x23, /**<Physical descriptor*/
+} USB_HID_DESCRIPTOR_TYPE_t;
+
+/**
+ * @ingroup usb_hid
+ * @enum USB_HID_REQUEST_ID_t
+ * @brief Type define for the HID class-specific requests, in bRequest.
+ */
+typedef enum USB_HID_REQUEST_ID_enum
+{
+    USB_HID_REQUEST_GET_REPORT = 0x01,   /**<Reads a report over the control pipe*/
+    USB_HID_REQUEST_GET_IDLE = 0x02,     /**<Reads the idle rate*/
+    USB_HID_REQUEST_GET_PROTOCOL = 0x03, /**<Reads the active protocol, boot devices only*/
+    USB_HID_REQUEST_SET_REPORT = 0x09,   /**<Writes a report over the control pipe*/
+    USB_HID_REQUEST_SET_IDLE = 0x0A,     /**<Sets the idle rate, in 4 ms steps*/
+    USB_HID_REQUEST_SET_PROTOCOL = 0x0B, /**<Selects the boot or report protocol, boot devices only*/
+} USB_HID_REQUEST_ID_t;
+
+/**
+ * @ingroup usb_hid
+ * @enum USB_HID_REPORT_TYPE_t
+ * @brief Type define for the report types, in the high byte of wValue of Get_Report and Set_Report.
+ */
+typedef enum USB_HID_REPORT_TYPE_enum
+{
+    USB_HID_REPORT_TYPE_INPUT = 0x01,   /**<Device-to-host report*/
+    USB_HID_REPORT_TYPE_OUTPUT = 0x02,  /**<Host-to-device report*/
+    USB_HID_REPORT_TYPE_FEATURE = 0x03, /**<Configuration report, both directions*/
+} USB_HID_REPORT_TYPE_t;
+
+/**
+ * @ingroup usb_hid
+ * @struct USB_HID_DESCRIPTOR_t
+ * @brief Type define for the HID descriptor with one report descriptor.
+ */
+typedef struct USB_HID_DESCRIPTOR_struct
+{
+    USB_DESCRIPTOR_HEADER_t header;   /**<Descriptor type and size*/
+    uint16_t bcdHID;                  /**<Version of the HID specification*/
+    uint8_t bCountryCode;             /**<Country of localized hardware, 0 if not localized*/
+    uint8_t bNumDescriptors;          /**<Number of class descriptors, at least the report descriptor*/
+    uint8_t bReportDescriptorType;    /**<USB_HID_DESCRIPTOR_TYPE_REPORT*/
+    uint16_t wReportDescriptorLength; /**<Size of the report descriptor in bytes*/
+} USB_HID_DESCRIPTOR_t;
+
+#endif /* USB_PROTOCOL_HID_H */
@@ -0,0 +1,155 @@
+/**
+ * USBPROTOCOLVENDOR Vendor Protocol Header File
+ * @file usb_protocol_vendor.h
+ * @ingroup usb_vendor
+ * @brief USB vendor-specific interface and Microsoft OS 2.0 descriptor definitions
+ */
+
+#ifndef USB_PROTOCOL_VENDOR_H
+#define USB_PROTOCOL_VENDOR_H
+
+#include <stdint.h>
+#include <usb_protocol_headers.h>
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_VENDOR_INTERFACE_CLASS
+ * @brief Interface class code of a vendor-specific interface.
+ */
+#define USB_VENDOR_INTERFACE_CLASS 0xFFU
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_DEVICE_CAPABILITY_PLATFORM
+ * @brief bDevCapabilityType of a platform capability descriptor in the BOS.
+ */
+#define USB_DEVICE_CAPABILITY_PLATFORM 0x05U
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_MS_OS_20_PLATFORM_CAPABILITY_UUID
+ * @brief Platform capability UUID {D8DD60DF-4589-4CC7-9CD2-659D9E648A9F} of the Microsoft OS 2.0 descriptors, in descriptor byte order.
+ */
+#define USB_MS_OS_20_PLATFORM_CAPABILITY_UUID {0xDF, 0x60, 0xDD, 0xD8, 0x89, 0x45, 0xC7, 0x4C, 0x9C, 0xD2, 0x65, 0x9D, 0x9E, 0x64, 0x8A, 0x9F}
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_MS_OS_20_WINDOWS_VERSION_8_1
+ * @brief dwWindowsVersion for Windows 8.1, the first version that reads Microsoft OS 2.0 descriptors.
+ */
+#define USB_MS_OS_20_WINDOWS_VERSION_8_1 0x06030000UL
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_MS_OS_20_DESCRIPTOR_INDEX
+ * @brief wIndex of the vendor request that reads the Microsoft OS 2.0 descriptor set.
+ */
+#define USB_MS_OS_20_DESCRIPTOR_INDEX 0x07U
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_MS_OS_20_REG_MULTI_SZ
+ * @brief wPropertyDataType of a registry property holding a list of UTF-16 strings.
+ */
+#define USB_MS_OS_20_REG_MULTI_SZ 0x07U
+
+/**
+ * @ingroup usb_vendor
+ * @enum USB_MS_OS_20_DESCRIPTOR_TYPE_t
+ * @brief Type define for the Microsoft OS 2.0 descriptor types.
+ */
+typedef enum USB_MS_OS_20_DESCRIPTOR_TYPE_enum
+{
+    USB_MS_OS_20_SET_HEADER_DESCRIPTOR = 0x00,       /**<Header of the descriptor set*/
+    USB_MS_OS_20_SUBSET_HEADER_CONFIGURATION = 0x01, /**<Header of the descriptors that apply to one configuration*/
+    USB_MS_OS_20_SUBSET_HEADER_FUNCTION = 0x02,      /**<Header of the descriptors that apply to one function*/
+    USB_MS_OS_20_FEATURE_COMPATIBLE_ID = 0x03,       /**<Compatible ID, selects the Windows driver*/
+    USB_MS_OS_20_FEATURE_REG_PROPERTY = 0x04,        /**<Registry property added to the device or function key*/
+} USB_MS_OS_20_DESCRIPTOR_TYPE_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_PLATFORM_CAPABILITY_DESCRIPTOR_t
+ * @brief Type define for the BOS platform capability descriptor announcing Microsoft OS 2.0 descriptors.
+ */
+typedef struct USB_MS_OS_20_PLATFORM_CAPABILITY_DESCRIPTOR_struct
+{
+    USB_DESCRIPTOR_HEADER_t header;         /**<Descriptor type and size*/
+    uint8_t bDevCapabilityType;             /**<USB_DEVICE_CAPABILITY_PLATFORM*/
+    uint8_t bReserved;                      /**<Must be zero*/
+    uint8_t PlatformCapabilityUUID[16];     /**<USB_MS_OS_20_PLATFORM_CAPABILITY_UUID*/
+    uint32_t dwWindowsVersion;              /**<Minimum Windows version of the descriptor set*/
+    uint16_t wMSOSDescriptorSetTotalLength; /**<Size of the descriptor set in bytes*/
+    uint8_t bMS_VendorCode;                 /**<bRequest of the vendor request that reads the descriptor set*/
+    uint8_t bAltEnumCode;                   /**<Non-zero if the device supports alternate enumeration*/
+} USB_MS_OS_20_PLATFORM_CAPABILITY_DESCRIPTOR_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_SET_HEADER_DESCRIPTOR_t
+ * @brief Type define for the Microsoft OS 2.0 descriptor set header.
+ */
+typedef struct USB_MS_OS_20_SET_HEADER_DESCRIPTOR_struct
+{
+    uint16_t wLength;          /**<Size of this header in bytes*/
+    uint16_t wDescriptorType;  /**<USB_MS_OS_20_SET_HEADER_DESCRIPTOR*/
+    uint32_t dwWindowsVersion; /**<Minimum Windows version of the descriptor set*/
+    uint16_t wTotalLength;     /**<Size of the descriptor set in bytes, including this header*/
+} USB_MS_OS_20_SET_HEADER_DESCRIPTOR_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_CONFIGURATION_SUBSET_HEADER_t
+ * @brief Type define for the Microsoft OS 2.0 configuration subset header.
+ */
+typedef struct USB_MS_OS_20_CONFIGURATION_SUBSET_HEADER_struct
+{
+    uint16_t wLength;            /**<Size of this header in bytes*/
+    uint16_t wDescriptorType;    /**<USB_MS_OS_20_SUBSET_HEADER_CONFIGURATION*/
+    uint8_t bConfigurationValue; /**<Index of the configuration, not its bConfigurationValue*/
+    uint8_t bReserved;           /**<Must be zero*/
+    uint16_t wTotalLength;       /**<Size of the configuration subset in bytes, including this header*/
+} USB_MS_OS_20_CONFIGURATION_SUBSET_HEADER_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_FUNCTION_SUBSET_HEADER_t
+ * @brief Type define for the Microsoft OS 2.0 function subset header.
+ */
+typedef struct USB_MS_OS_20_FUNCTION_SUBSET_HEADER_struct
+{
+    uint16_t wLength;         /**<Size of this header in bytes*/
+    uint16_t wDescriptorType; /**<USB_MS_OS_20_SUBSET_HEADER_FUNCTION*/
+    uint8_t bFirstInterface;  /**<First interface of the function*/
+    uint8_t bReserved;        /**<Must be zero*/
+    uint16_t wSubsetLength;   /**<Size of the function subset in bytes, including this header*/
+} USB_MS_OS_20_FUNCTION_SUBSET_HEADER_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_COMPATIBLE_ID_DESCRIPTOR_t
+ * @brief Type define for the Microsoft OS 2.0 compatible ID descriptor.
+ */
+typedef struct USB_MS_OS_20_COMPATIBLE_ID_DESCRIPTOR_struct
+{
+    uint16_t wLength;           /**<Size of this descriptor in bytes*/
+    uint16_t wDescriptorType;   /**<USB_MS_OS_20_FEATURE_COMPATIBLE_ID*/
+    uint8_t CompatibleID[8];    /**<Compatible ID string, padded with zeros*/
+    uint8_t SubCompatibleID[8]; /**<Sub-compatible ID string, padded with zeros*/
+} USB_MS_OS_20_COMPATIBLE_ID_DESCRIPTOR_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_MS_OS_20_REGISTRY_PROPERTY_HEADER_t
+ * @brief Type define for the fixed start of a Microsoft OS 2.0 registry property descriptor.
+ *        It is followed by the property name, wPropertyDataLength and the property data.
+ */
+typedef struct USB_MS_OS_20_REGISTRY_PROPERTY_HEADER_struct
+{
+    uint16_t wLength;             /**<Size of the whole registry property descriptor in bytes*/
+    uint16_t wDescriptorType;     /**<USB_MS_OS_20_FEATURE_REG_PROPERTY*/
+    uint16_t wPropertyDataType;   /**<Registry value type, e.g. USB_MS_OS_20_REG_MULTI_SZ*/
+    uint16_t wPropertyNameLength; /**<Size of the property name in bytes, including the null character*/
+} USB_MS_OS_20_REGISTRY_PROPERTY_HEADER_t;
+
+#endif /* USB_PROTOCOL_VENDOR_H */
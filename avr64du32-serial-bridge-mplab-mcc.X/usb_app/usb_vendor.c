@@ -0,0 +1,388 @@
+/**
+ * USBVENDOR Vendor Interface Source File
+ * @file usb_vendor.c
+ * @ingroup usb_vendor
+ * @brief This file contains the implementation of the vendor-specific bulk interface
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <usb_vendor.h>
+#include <usb_core.h>
+#include <usb_core_transfer.h>
+#include <usb_protocol_headers.h>
+#include <usb_config.h>
+#include <usb_peripheral.h>
+
+// Microsoft OS 2.0 descriptor set, read with the vendor code announced in the BOS
+STATIC uint8_t *usbVendorDescriptorSetPtr = NULL;
+STATIC uint16_t usbVendorDescriptorSetLength = 0;
+
+// Vendor requests not handled here
+STATIC USB_SETUP_PROCESS_CALLBACK_t usbVendorApplicationRequestCallback = NULL;
+
+// USB Pipes
+STATIC USB_PIPE_t VendorTxPipe = {
+    .address = USB_VENDOR_BULK_EP_IN,
+    .direction = USB_EP_DIR_IN,
+};
+
+STATIC USB_PIPE_t VendorRxPipe = {
+    .address = USB_VENDOR_BULK_EP_OUT,
+    .direction = USB_EP_DIR_OUT,
+};
+
+// Loopback buffers, used in order. Multipacket OUT transfers must be word aligned.
+STATIC uint8_t usbVendorBuffer[USB_VENDOR_BUFFER_NUM][USB_VENDOR_TRANSFER_SIZE] __attribute__((aligned(2)));
+STATIC uint16_t usbVendorBufferLength[USB_VENDOR_BUFFER_NUM];
+STATIC uint8_t usbVendorReadIndex;
+STATIC uint8_t usbVendorWriteIndex;
+STATIC uint8_t usbVendorBuffersFilled;
+
+// Loopback counters, and the copy sent in the data stage of the statistics request
+STATIC USB_VENDOR_LOOPBACK_STATISTICS_t usbVendorStatistics;
+STATIC USB_VENDOR_LOOPBACK_STATISTICS_t usbVendorStatisticsReport;
+
+#if USB_VENDOR_STREAM_ENABLE
+// The frame number in the SOF token has 11 bits
+#define USB_VENDOR_STREAM_FRAME_NUMBER_MASK 0x07FFU
+
+STATIC USB_PIPE_t VendorStreamPipe = {
+    .address = USB_VENDOR_STREAM_EP_IN,
+    .direction = USB_EP_DIR_IN,
+};
+
+// Stream packet, only written while the pipe is idle
+STATIC USB_VENDOR_STREAM_PACKET_t usbVendorStreamPacket;
+STATIC USB_VENDOR_STREAM_SAMPLE_CALLBACK_t usbVendorStreamSampleCallback = NULL;
+
+// Sequence and frame number of the last SOF, set until its packet is sent
+STATIC uint16_t usbVendorStreamSequence;
+STATIC uint16_t usbVendorStreamFrameNumber;
+STATIC bool usbVendorStreamFramePending;
+STATIC bool usbVendorStreamStarted;
+
+void USB_VendorStreamStartOfFrame(void)
+{
+    uint16_t frameNumber = USB_FrameNumberGet();
+
+    if (true == USB_VendorStreamIsActive())
+    {
+        if (true == usbVendorStreamStarted)
+        {
+            // Frames without an SOF event, the main loop was busy, count as well so the host sees the gap
+            usbVendorStreamSequence += (frameNumber - usbVendorStreamFrameNumber) & USB_VENDOR_STREAM_FRAME_NUMBER_MASK;
+        }
+        else
+        {
+            usbVendorStreamSequence = 0;
+            usbVendorStreamStarted = true;
+        }
+        usbVendorStreamFrameNumber = frameNumber;
+        usbVendorStreamFramePending = true;
+    }
+    else
+    {
+        // The next stream starts at sequence 0
+        usbVendorStreamStarted = false;
+        usbVendorStreamFramePending = false;
+    }
+}
+#endif
+
+STATIC void USB_VendorLoopbackReset(void)
+{
+    usbVendorReadIndex = 0;
+    usbVendorWriteIndex = 0;
+    usbVendorBuffersFilled = 0;
+}
+
+STATIC void USB_VendorStatisticsClear(void)
+{
+    usbVendorStatistics.bytesReceived = 0;
+    usbVendorStatistics.bytesTransmitted = 0;
+    usbVendorStatistics.transfers = 0;
+}
+
+void USB_VendorInitialize(uint8_t *descriptorSetPtr, uint16_t descriptorSetLength)
+{
+    usbVendorDescriptorSetPtr = descriptorSetPtr;
+    usbVendorDescriptorSetLength = descriptorSetLength;
+
+    USB_VendorLoopbackReset();
+    USB_VendorStatisticsClear();
+
+    USB_VendorRequestCallbackRegister(USB_VendorRequestHandler);
+#if USB_VENDOR_STREAM_ENABLE
+    usbVendorStreamStarted = false;
+    usbVendorStreamFramePending = false;
+#endif
+}
+
+RETURN_CODE_t USB_VendorRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr)
+{
+    RETURN_CODE_t status = UNINITIALIZED;
+    uint16_t length;
+
+    // The requests of the vendor interface are device-to-host reads
+    if (USB_REQUEST_DIR_IN == setupRequestPtr->bmRequestType.dataPhaseTransferDirection)
+    {
+        switch (setupRequestPtr->bRequest)
+        {
+        case USB_VENDOR_MS_OS_20_VENDOR_CODE:
+            if ((USB_MS_OS_20_DESCRIPTOR_INDEX == setupRequestPtr->wIndex) && (NULL != usbVendorDescriptorSetPtr))
+            {
+                // The host reads the header first, then the whole set
+                length = usbVendorDescriptorSetLength;
+                if (length > setupRequestPtr->wLength)
+                {
+                    length = setupRequestPtr->wLength;
+                }
+                status = USB_TransferControlDataSet(usbVendorDescriptorSetPtr, length, NULL);
+            }
+            else
+            {
+                status = UNSUPPORTED; // Other Microsoft OS 2.0 indexes are not used
+            }
+            break;
+        case USB_VENDOR_REQUEST_GET_LOOPBACK_STATISTICS:
+            // The counters keep changing, the data stage sends a copy
+            usbVendorStatisticsReport = usbVendorStatistics;
+            if (1U == setupRequestPtr->wValue)
+            {
+                USB_VendorStatisticsClear();
+            }
+            length = sizeof(USB_VENDOR_LOOPBACK_STATISTICS_t);
+            if (length > setupRequestPtr->wLength)
+            {
+                length = setupRequestPtr->wLength;
+            }
+            status = USB_TransferControlDataSet((uint8_t *)&usbVendorStatisticsReport, length, NULL);
+            break;
+        default:
+            status = UNINITIALIZED; // Not a request of the vendor interface
+            break;
+        }
+    }
+
+    if (UNINITIALIZED == status)
+    {
+        if (NULL != usbVendorApplicationRequestCallback)
+        {
+            status = usbVendorApplicationRequestCallback(setupRequestPtr);
+        }
+        else
+        {
+            status = UNSUPPORTED; // Currently unsupported request
+        }
+    }
+
+    return status;
+}
+
+void USB_VendorApplicationRequestCallbackRegister(USB_SETUP_PROCESS_CALLBACK_t callback)
+{
+    usbVendorApplicationRequestCallback = callback;
+}
+
+STATIC RETURN_CODE_t USB_VendorReceiveHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+
+    // Checks if a buffer is free for the next OUT transfer
+    if (USB_VENDOR_BUFFER_NUM > usbVendorBuffersFilled)
+    {
+        // Receives data from host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(VendorRxPipe))
+        {
+            status = USB_TransferReadStart(VendorRxPipe, usbVendorBuffer[usbVendorReadIndex], USB_VENDOR_TRANSFER_SIZE, false, USB_VendorDataReceived);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // All buffers wait to be sent back, the host is NAKed until one is free
+    }
+
+    return status;
+}
+
+STATIC RETURN_CODE_t USB_VendorTransmitHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+    uint16_t length;
+
+    // Checks if received data waits to be sent back
+    if (0U != usbVendorBuffersFilled)
+    {
+        // Transmits data to host if pipe not busy
+        if (false == USB_PipeStatusIsBusy(VendorTxPipe))
+        {
+            // A short OUT transfer ended a host transfer, so the IN transfer ends the same way, with a ZLP if needed
+            length = usbVendorBufferLength[usbVendorWriteIndex];
+            status = USB_TransferWriteStart(VendorTxPipe, usbVendorBuffer[usbVendorWriteIndex], length, (USB_VENDOR_TRANSFER_SIZE > length), USB_VendorDataTransmitted);
+        }
+        else
+        {
+            // Pipe is busy, retry on next iteration
+        }
+    }
+    else
+    {
+        // No data to transmit
+    }
+
+    return status;
+}
+
+#if USB_VENDOR_STREAM_ENABLE
+STATIC RETURN_CODE_t USB_VendorStreamHandler(void)
+{
+    RETURN_CODE_t status = SUCCESS;
+    uint8_t length = 0;
+
+    // Checks if a frame started since the last packet
+    if (true == usbVendorStreamFramePending)
+    {
+        usbVendorStreamFramePending = false;
+
+        // Transmits the packet if the one of the last frame was read
+        if (false == USB_PipeStatusIsBusy(VendorStreamPipe))
+        {
+            usbVendorStreamPacket.header.sequence = usbVendorStreamSequence;
+            usbVendorStreamPacket.header.frameNumber = usbVendorStreamFrameNumber;
+            if (NULL != usbVendorStreamSampleCallback)
+            {
+                length = usbVendorStreamSampleCallback(usbVendorStreamPacket.data, USB_VENDOR_STREAM_DATA_SIZE);
+            }
+            status = USB_TransferWriteStart(VendorStreamPipe, (uint8_t *)&usbVendorStreamPacket, sizeof(USB_VENDOR_STREAM_HEADER_t) + length, false, NULL);
+        }
+        else
+        {
+            // The host did not read the last packet yet, this frame shows as a gap in the sequence
+        }
+    }
+    else
+    {
+        // No new frame
+    }
+
+    return status;
+}
+#endif
+
+RETURN_CODE_t USB_VendorHandler(void)
+{
+    RETURN_CODE_t status;
+    RETURN_CODE_t stepStatus;
+
+    // Each direction runs on its own, an error on one does not stall the other
+    status = USB_VendorTransmitHandler();
+
+    stepStatus = USB_VendorReceiveHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+
+#if USB_VENDOR_STREAM_ENABLE
+    stepStatus = USB_VendorStreamHandler();
+    if (SUCCESS == status)
+    {
+        status = stepStatus;
+    }
+#endif
+
+    return status;
+}
+
+RETURN_CODE_t USB_VendorPipesReset(void)
+{
+    RETURN_CODE_t status = USB_TransferAbort(VendorTxPipe);
+    RETURN_CODE_t pipeStatus;
+
+    pipeStatus = USB_TransferAbort(VendorRxPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+
+#if USB_VENDOR_STREAM_ENABLE
+    pipeStatus = USB_TransferAbort(VendorStreamPipe);
+    if (SUCCESS == status)
+    {
+        status = pipeStatus;
+    }
+#endif
+
+    // Loopback data has no other copy, start over with empty buffers
+    USB_VendorLoopbackReset();
+
+    return status;
+}
+
+const USB_VENDOR_LOOPBACK_STATISTICS_t *USB_VendorLoopbackStatisticsGet(void)
+{
+    return &usbVendorStatistics;
+}
+
+#if USB_VENDOR_STREAM_ENABLE
+void USB_VendorStreamSampleCallbackRegister(USB_VENDOR_STREAM_SAMPLE_CALLBACK_t callback)
+{
+    usbVendorStreamSampleCallback = callback;
+}
+
+bool USB_VendorStreamIsActive(void)
+{
+    uint8_t alternateSetting = 0U;
+
+    if (USB_REQUEST_DEVICE_DISABLE_CONFIGURATION != USB_DescriptorActiveConfigurationValueGet())
+    {
+        (void)ActiveAlternateSettingGet(USB_VENDOR_INTERFACE, &alternateSetting);
+    }
+
+    return (USB_VENDOR_STREAM_ALTERNATE == alternateSetting);
+}
+#endif
+
+void USB_VendorDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+
+    if (USB_PIPE_TRANSFER_OK == status)
+    {
+        // Queues the buffer to be sent back
+        usbVendorBufferLength[usbVendorReadIndex] = bytesTransferred;
+        usbVendorReadIndex = (usbVendorReadIndex + 1U) % USB_VENDOR_BUFFER_NUM;
+        usbVendorBuffersFilled++;
+
+        usbVendorStatistics.bytesReceived += bytesTransferred;
+        usbVendorStatistics.transfers++;
+    }
+    else
+    {
+        ; // Transfer aborted, the buffer stays free
+    }
+}
+
+void USB_VendorDataTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred)
+{
+    (void)(pipe);
+
+    if (USB_PIPE_TRANSFER_OK == status)
+    {
+        usbVendorStatistics.bytesTransmitted += bytesTransferred;
+
+        // The buffer is free for the next OUT transfer
+        usbVendorWriteIndex = (usbVendorWriteIndex + 1U) % USB_VENDOR_BUFFER_NUM;
+        usbVendorBuffersFilled--;
+    }
+    else
+    {
+        // Transfer aborted by a reset or a new configuration, drop the queued data as well
+        USB_VendorLoopbackReset();
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * USBVENDOR Vendor Interface Header File
+ * @file usb_vendor.h
+ * @defgroup usb_vendor USB Vendor-Specific Interface
+ * @brief This file contains prototypes and data types for the vendor-specific bulk interface
+ */
+
+#ifndef USB_VENDOR_H
+#define USB_VENDOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <usb_core.h>
+#include <usb_common_elements.h>
+#include <usb_protocol_vendor.h>
+#include <usb_config.h>
+
+/**
+ * @ingroup usb_vendor
+ * @enum USB_VENDOR_REQUEST_ID_t
+ * @brief Type define for the vendor control requests handled by the vendor interface, in bRequest.
+ * Other vendor requests are passed to the application callback.
+ */
+typedef enum USB_VENDOR_REQUEST_ID_enum
+{
+    USB_VENDOR_REQUEST_GET_LOOPBACK_STATISTICS = 0x01, /**<Returns USB_VENDOR_LOOPBACK_STATISTICS_t, wValue = 1 clears the counters afterwards*/
+} USB_VENDOR_REQUEST_ID_t;
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_VENDOR_LOOPBACK_STATISTICS_t
+ * @brief Type define for the loopback counters, the host divides them by its own elapsed time.
+ */
+typedef struct USB_VENDOR_LOOPBACK_STATISTICS_struct
+{
+    uint32_t bytesReceived;    /**<Bytes received on the bulk OUT endpoint*/
+    uint32_t bytesTransmitted; /**<Bytes sent back on the bulk IN endpoint*/
+    uint16_t transfers;        /**<Completed OUT transfers, wraps around*/
+} USB_VENDOR_LOOPBACK_STATISTICS_t;
+
+#if USB_VENDOR_STREAM_ENABLE
+/**
+ * @ingroup usb_vendor
+ * @struct USB_VENDOR_STREAM_HEADER_t
+ * @brief Type define for the header at the start of each isochronous stream packet.
+ */
+typedef struct USB_VENDOR_STREAM_HEADER_struct
+{
+    uint16_t sequence;    /**<Frames since the stream alternate setting was selected, a jump of more than 1 means packets were not sent*/
+    uint16_t frameNumber; /**<Frame number of the SOF the data was sampled in*/
+} USB_VENDOR_STREAM_HEADER_t;
+
+/**
+ * @ingroup usb_vendor
+ * @def USB_VENDOR_STREAM_DATA_SIZE
+ * @brief Space for sampled data in each stream packet.
+ */
+#define USB_VENDOR_STREAM_DATA_SIZE (USB_VENDOR_STREAM_PACKET_SIZE - sizeof(USB_VENDOR_STREAM_HEADER_t))
+
+/**
+ * @ingroup usb_vendor
+ * @struct USB_VENDOR_STREAM_PACKET_t
+ * @brief Type define for an isochronous stream packet.
+ */
+typedef struct USB_VENDOR_STREAM_PACKET_struct
+{
+    USB_VENDOR_STREAM_HEADER_t header;         /**<Sequence and frame number*/
+    uint8_t data[USB_VENDOR_STREAM_DATA_SIZE]; /**<Sampled data, length set by the sample callback*/
+} USB_VENDOR_STREAM_PACKET_t;
+
+/**
+ * @ingroup usb_vendor
+ * @typedef uint8_t (*USB_VENDOR_STREAM_SAMPLE_CALLBACK_t)(uint8_t *dataPtr, uint8_t maxLength)
+ * @brief Type define for the function that samples the data of one stream packet, once per frame.
+ * Returns the number of bytes written to dataPtr, at most maxLength.
+ */
+typedef uint8_t (*USB_VENDOR_STREAM_SAMPLE_CALLBACK_t)(uint8_t *dataPtr, uint8_t maxLength);
+#endif
+
+/**
+ * @ingroup usb_vendor
+ * @brief Initializes the vendor interface and registers its vendor request handler.
+ * @param descriptorSetPtr - Pointer to the Microsoft OS 2.0 descriptor set
+ * @param descriptorSetLength - Size of the descriptor set in bytes
+ * @return None.
+ */
+void USB_VendorInitialize(uint8_t *descriptorSetPtr, uint16_t descriptorSetLength);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Performs handling of vendor control requests, including the Microsoft OS 2.0 descriptor request.
+ * @param setupRequestPtr - Pointer to the Setup Request struct
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_VendorRequestHandler(USB_SETUP_REQUEST_t *setupRequestPtr);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Registers a callback for the vendor requests not handled by the vendor interface.
+ * @param callback - Function called with the setup request, or NULL to stall all other vendor requests
+ * @return None.
+ */
+void USB_VendorApplicationRequestCallbackRegister(USB_SETUP_PROCESS_CALLBACK_t callback);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Starts the bulk transfers of the loopback, data received on the OUT endpoint is sent back on the IN endpoint.
+ * Also sends the stream packet of the last frame, while the stream alternate setting is selected.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_VendorHandler(void);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Aborts the transfers on the vendor bulk and stream pipes, data waiting to be sent back is dropped.
+ * @param None.
+ * @return SUCCESS or an Error code according to RETURN_CODE_t
+ */
+RETURN_CODE_t USB_VendorPipesReset(void);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Returns the loopback counters.
+ * @param None.
+ * @return Pointer to the loopback counters
+ */
+const USB_VENDOR_LOOPBACK_STATISTICS_t *USB_VendorLoopbackStatisticsGet(void);
+
+#if USB_VENDOR_STREAM_ENABLE
+/**
+ * @ingroup usb_vendor
+ * @brief Registers the function that samples the data of each stream packet.
+ * @param callback - Function called once per frame while the stream is active, or NULL to send the header only
+ * @return None.
+ */
+void USB_VendorStreamSampleCallbackRegister(USB_VENDOR_STREAM_SAMPLE_CALLBACK_t callback);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Checks if the host has selected the stream alternate setting of the vendor interface.
+ * @param None.
+ * @return true if stream packets are sent, false otherwise
+ */
+bool USB_VendorStreamIsActive(void);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Starts the packet of a new frame. The Start-of-Frame flag is taken by the application interrupt,
+ * which calls this once per Start-of-Frame before USB_VendorHandler.
+ * @param None.
+ * @return None.
+ */
+void USB_VendorStreamStartOfFrame(void);
+#endif
+
+/**
+ * @ingroup usb_vendor
+ * @brief Callback function called after a bulk OUT transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes received in the transfer
+ * @return None.
+ */
+void USB_VendorDataReceived(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+/**
+ * @ingroup usb_vendor
+ * @brief Callback function called after a bulk IN transfer has completed.
+ * @param pipe - USB pipe used for the transfer
+ * @param status - Transfer status
+ * @param bytesTransferred - Number of bytes transmitted in the transfer
+ * @return None.
+ */
+void USB_VendorDataTransmitted(USB_PIPE_t pipe, USB_TRANSFER_STATUS_t status, uint16_t bytesTransferred);
+
+#endif /* USB_VENDOR_H */
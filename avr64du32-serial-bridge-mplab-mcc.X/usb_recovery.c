@@ -0,0 +1,197 @@
+#include "usb_recovery.h"
+
+#include <xc.h>
+#include "mcc_generated_files/system/system.h"
+#include "usb_core.h"
+#include "usb_device.h"
+#include "usb_cdc_virtual_serial_port.h"
+#if USB_VENDOR_ENABLE
+#include "usb_vendor.h"
+#endif
+#if USB_CDC_DATA_PORT_ENABLE
+#include "usb_cdc_data_port.h"
+#endif
+#if USB_HID_ENABLE
+#include "usb_hid.h"
+#endif
+#include "timebase.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+static usb_recovery_stats_t stats;
+
+//Time of the last error, and whether the stack has run cleanly since
+static uint32_t errorTime = 0;
+static bool isRecovering = false;
+
+//Pipe resets since the stack last ran for USB_RECOVERY_STABLE_MS without errors
+static uint8_t pipeResetCount = 0;
+
+//Wait before the next USB_Reset, 0 resets immediately
+static uint32_t backoffStart = 0;
+static uint16_t backoffMs = 0;
+
+//Adds 1 to COUNTER, stops at the maximum
+static void USBRecovery_Increment(uint16_t* counter)
+{
+    if (*counter != UINT16_MAX)
+    {
+        (*counter)++;
+    }
+}
+
+//Returns true if ERROR only affects the transfer in progress
+static bool USBRecovery_IsRecoverable(RETURN_CODE_t error)
+{
+    switch (error)
+    {
+        case PIPE_BUSY_ERROR:
+        case PIPE_TRANSFER_ERROR:
+        case CONTROL_SIZE_ERROR:
+        case CONTROL_TRANSACTION_STATUS_ERROR:
+        case CONTROL_SETUP_CALLBACK_ERROR:
+        case CONTROL_SETUP_DIRECTION_ERROR:
+        {
+            return true;
+        }
+        default:
+        {
+            //Endpoint, descriptor, interface and connection errors
+            return false;
+        }
+    }
+}
+
+//Resets the pipes affected by ERROR
+static RETURN_CODE_t USBRecovery_PipeReset(usb_recovery_source_t source, RETURN_CODE_t error)
+{
+    if ((source == USB_RECOVERY_SOURCE_DEVICE) && (error <= CONTROL_SIZE_ERROR) && (error >= CONTROL_SETUP_DIRECTION_ERROR))
+    {
+        //Control endpoint, wait for the next SETUP
+        return USB_ControlTransferReset();
+    }
+
+#if USB_VENDOR_ENABLE
+    if (source == USB_RECOVERY_SOURCE_VENDOR)
+    {
+        return USB_VendorPipesReset();
+    }
+#endif
+
+#if USB_CDC_DATA_PORT_ENABLE
+    if (source == USB_RECOVERY_SOURCE_CDC_DATA)
+    {
+        return USB_CDCDataPortPipesReset();
+    }
+#endif
+
+#if USB_HID_ENABLE
+    if (source == USB_RECOVERY_SOURCE_HID)
+    {
+        return USB_HIDPipesReset();
+    }
+#endif
+
+    //Device errors outside the control endpoint reset the CDC pipes
+    return USB_CDCPipesReset();
+}
+
+void USBRecovery_Initialize(void)
+{
+    stats.pipeResets = 0;
+    stats.usbResets = 0;
+    stats.failedResets = 0;
+    stats.lastError = SUCCESS;
+    stats.lastRecoveryMs = 0;
+    stats.maxRecoveryMs = 0;
+
+    isRecovering = false;
+    pipeResetCount = 0;
+    backoffMs = 0;
+}
+
+bool USBRecovery_HandleError(usb_recovery_source_t source, RETURN_CODE_t error)
+{
+    stats.lastError = error;
+    errorTime = Timebase_GetMillis();
+    isRecovering = true;
+
+    if ((USBRecovery_IsRecoverable(error)) && (pipeResetCount < USB_RECOVERY_PIPE_RESET_LIMIT))
+    {
+        pipeResetCount++;
+        USBRecovery_Increment(&stats.pipeResets);
+
+        if (USBRecovery_PipeReset(source, error) == SUCCESS)
+        {
+            //Let the stack run again
+            USBDevice_StatusClear();
+            return true;
+        }
+    }
+
+    //Fatal, or the pipes keep failing
+    backoffStart = errorTime;
+    return false;
+}
+
+void USBRecovery_Clean(void)
+{
+    uint32_t elapsed;
+
+    if (isRecovering)
+    {
+        //First clean pass since the error
+        isRecovering = false;
+        elapsed = Timebase_GetMillis() - errorTime;
+
+        stats.lastRecoveryMs = (elapsed > UINT16_MAX) ? UINT16_MAX : elapsed;
+        if (stats.lastRecoveryMs > stats.maxRecoveryMs)
+        {
+            stats.maxRecoveryMs = stats.lastRecoveryMs;
+        }
+    }
+    else if (((pipeResetCount != 0) || (backoffMs != 0)) && (Timebase_HasElapsed(errorTime, USB_RECOVERY_STABLE_MS)))
+    {
+        //Stable again, start over
+        pipeResetCount = 0;
+        backoffMs = 0;
+    }
+}
+
+bool USBRecovery_ResetTask(void)
+{
+    if (!Timebase_HasElapsed(backoffStart, backoffMs))
+    {
+        return false;
+    }
+
+    USBRecovery_Increment(&stats.usbResets);
+
+    //A reset that doesn't hold waits longer next time, until the stack is stable again
+    if (backoffMs == 0)
+    {
+        backoffMs = USB_RECOVERY_BACKOFF_MIN_MS;
+    }
+    else if (backoffMs < USB_RECOVERY_BACKOFF_MAX_MS)
+    {
+        backoffMs <<= 1;
+    }
+
+    //Detaches, reinitializes the peripheral and attaches again
+    if (USB_Reset() == SUCCESS)
+    {
+        USBDevice_StatusClear();
+        pipeResetCount = 0;
+        return true;
+    }
+
+    USBRecovery_Increment(&stats.failedResets);
+    backoffStart = Timebase_GetMillis();
+    return false;
+}
+
+const usb_recovery_stats_t* USBRecovery_GetStats(void)
+{
+    return &stats;
+}
@@ -0,0 +1,59 @@
+#ifndef USB_RECOVERY_H
+#define	USB_RECOVERY_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usb_common_elements.h"
+
+//First wait before USB_Reset is retried, doubles after each failed reset
+#define USB_RECOVERY_BACKOFF_MIN_MS 1
+
+//Longest wait between two USB_Reset attempts
+#define USB_RECOVERY_BACKOFF_MAX_MS 256
+
+//Pipe resets allowed before the next error is treated as fatal
+#define USB_RECOVERY_PIPE_RESET_LIMIT 8
+
+//Error-free time after which the pipe reset limit and the backoff start over
+#define USB_RECOVERY_STABLE_MS 100
+
+    typedef enum {
+        USB_RECOVERY_SOURCE_CDC = 0, USB_RECOVERY_SOURCE_DEVICE, USB_RECOVERY_SOURCE_VENDOR, USB_RECOVERY_SOURCE_CDC_DATA, USB_RECOVERY_SOURCE_HID
+    } usb_recovery_source_t;
+
+    typedef struct {
+        uint16_t pipeResets;
+        uint16_t usbResets;
+        uint16_t failedResets;
+        RETURN_CODE_t lastError;
+        uint16_t lastRecoveryMs;
+        uint16_t maxRecoveryMs;
+    } usb_recovery_stats_t;
+
+    //Initializes the recovery state and clears the counters
+    void USBRecovery_Initialize(void);
+
+    //Handles ERROR returned by the handler of SOURCE
+    //Recoverable errors reset the affected pipes and return true
+    //Fatal errors return false, USBRecovery_ResetTask must then run until it returns true
+    bool USBRecovery_HandleError(usb_recovery_source_t source, RETURN_CODE_t error);
+
+    //Call after a pass of the USB handlers without errors
+    void USBRecovery_Clean(void);
+
+    //Runs USB_Reset once the backoff has passed, returns true once the stack has been restarted
+    bool USBRecovery_ResetTask(void);
+
+    //Returns the recovery counters and times (saturating)
+    const usb_recovery_stats_t* USBRecovery_GetStats(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* USB_RECOVERY_H */
+
@@ -0,0 +1,54 @@
+#include "usb_timestamp.h"
+
+#include <xc.h>
+#include <util/atomic.h>
+#include "usb_peripheral.h"
+#include "timebase.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Frame number and time of the last SOF seen by the interrupt
+static volatile uint16_t anchorFrame = 0;
+static volatile uint32_t anchorMicros = 0;
+
+//Call from the USB bus event interrupt, latches the time of the SOF if its flag is set
+void USBTimestamp_StartOfFrame(void)
+{
+    if (USB_EventSOFIsReceived())
+    {
+        //Read the time first, the latency to here is the error of the anchor
+        anchorMicros = Timebase_GetMicros();
+        anchorFrame = USB_FrameNumberGet() & USB_TIMESTAMP_FRAME_MASK;
+    }
+}
+
+//Stamps the current time with the frame number and the offset into the frame
+//Without a recent SOF, the frame is extrapolated from the last one
+void USBTimestamp_Get(usb_timestamp_t* stamp)
+{
+    uint16_t frame;
+    uint32_t micros;
+    uint32_t elapsed;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        frame = anchorFrame;
+        micros = anchorMicros;
+    }
+    
+    //Unsigned math handles the wrap-around
+    elapsed = Timebase_GetMicros() - micros;
+    
+    stamp->frame = (frame + (uint16_t) (elapsed / USB_TIMESTAMP_FRAME_US)) & USB_TIMESTAMP_FRAME_MASK;
+    stamp->offset = (uint16_t) (elapsed % USB_TIMESTAMP_FRAME_US);
+}
+
+//Writes STAMP to DATA as USB_TIMESTAMP_SIZE bytes, LSB first
+void USBTimestamp_Write(const usb_timestamp_t* stamp, uint8_t* data)
+{
+    data[0] = (uint8_t) stamp->frame;
+    data[1] = (uint8_t) (stamp->frame >> 8);
+    data[2] = (uint8_t) stamp->offset;
+    data[3] = (uint8_t) (stamp->offset >> 8);
+}
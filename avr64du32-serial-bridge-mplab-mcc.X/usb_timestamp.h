@@ -0,0 +1,40 @@
+#ifndef USB_TIMESTAMP_H
+#define	USB_TIMESTAMP_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Length of a USB full-speed frame
+#define USB_TIMESTAMP_FRAME_US 1000U
+
+//The frame number is 11 bits, it wraps around every 2048 ms
+#define USB_TIMESTAMP_FRAME_MASK 0x07FFU
+
+//Size of a timestamp in the responses, frame then offset, LSB first
+#define USB_TIMESTAMP_SIZE 4
+
+    typedef struct {
+        uint16_t frame;     //USB frame number
+        uint16_t offset;    //Microseconds since the SOF of the frame, 0 to 999
+    } usb_timestamp_t;
+
+    //Call from the USB bus event interrupt, latches the time of the SOF if its flag is set
+    void USBTimestamp_StartOfFrame(void);
+
+    //Stamps the current time with the frame number and the offset into the frame
+    //Without a recent SOF, the frame is extrapolated from the last one
+    void USBTimestamp_Get(usb_timestamp_t* stamp);
+
+    //Writes STAMP to DATA as USB_TIMESTAMP_SIZE bytes, LSB first
+    void USBTimestamp_Write(const usb_timestamp_t* stamp, uint8_t* data);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* USB_TIMESTAMP_H */
+
@@ -0,0 +1,80 @@
+#include "vbus.h"
+
+#include <xc.h>
+#include <util/atomic.h>
+#include "mcc_generated_files/system/system.h"
+#include "timebase.h"
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Comparator output at the last edge, and when it happened
+static volatile bool vbusLevel = false;
+static volatile uint32_t edgeTime = 0;
+
+//Debounced VBUS state, and a detach the main loop hasn't seen yet
+static volatile bool isPresent = false;
+static volatile bool detachPending = false;
+
+//Called from the AC0 interrupt on every comparator edge
+static void VBUS_EdgeCallback(void)
+{
+    bool level = AC0_Read();
+
+    if (level == vbusLevel)
+    {
+        //Glitch, the output is back where it was
+        return;
+    }
+
+    vbusLevel = level;
+    edgeTime = Timebase_GetMillis();
+    Scheduler_Post(SCHEDULER_EVENT_VBUS);
+
+    if ((!level) && (isPresent))
+    {
+        //Detach takes effect immediately
+        isPresent = false;
+        detachPending = true;
+    }
+}
+
+//Samples VBUS and enables the AC0 edge callback
+void VBUS_Initialize(void)
+{
+    vbusLevel = AC0_Read();
+    edgeTime = Timebase_GetMillis();
+    isPresent = false;
+    detachPending = false;
+
+    AC0_CallbackRegister(VBUS_EdgeCallback);
+}
+
+//Returns the next VBUS change, detaches are reported first
+vbus_event_t VBUS_GetEvent(void)
+{
+    vbus_event_t event = VBUS_EVENT_NONE;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (detachPending)
+        {
+            detachPending = false;
+            event = VBUS_EVENT_DETACH;
+        }
+        else if ((vbusLevel) && (!isPresent) && (Timebase_HasElapsed(edgeTime, VBUS_ATTACH_DEBOUNCE_MS)))
+        {
+            isPresent = true;
+            event = VBUS_EVENT_ATTACH;
+        }
+    }
+
+    return event;
+}
+
+//Returns true while VBUS is present
+bool VBUS_IsPresent(void)
+{
+    return isPresent;
+}
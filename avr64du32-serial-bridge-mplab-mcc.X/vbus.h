@@ -0,0 +1,33 @@
+#ifndef VBUS_H
+#define	VBUS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//VBUS must stay above the AC0 threshold this long before an attach is reported
+#define VBUS_ATTACH_DEBOUNCE_MS 10
+
+    typedef enum {
+        VBUS_EVENT_NONE = 0, VBUS_EVENT_ATTACH, VBUS_EVENT_DETACH
+    } vbus_event_t;
+
+    //Samples VBUS and enables the AC0 edge callback
+    void VBUS_Initialize(void);
+
+    //Returns the next VBUS change, detaches are reported first
+    //Attaches are reported once VBUS has been stable for VBUS_ATTACH_DEBOUNCE_MS
+    vbus_event_t VBUS_GetEvent(void);
+
+    //Returns true while VBUS is present (cleared by the AC0 interrupt as soon as VBUS drops)
+    bool VBUS_IsPresent(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* VBUS_H */
+
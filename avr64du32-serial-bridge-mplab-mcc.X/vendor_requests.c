@@ -0,0 +1,244 @@
+#include "vendor_requests.h"
+
+#include "serial_bus.h"
+#include "stats.h"
+#include "usb_timestamp.h"
+#include "usb_core.h"
+#include "usb_core_transfer.h"
+#if USB_VENDOR_ENABLE
+#include "usb_vendor.h"
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//Offset of the data stage in the buffer
+//The control OUT data stage must be word aligned, the byte before it holds the register or command
+#define VENDOR_REQUESTS_DATA_OFFSET 2
+
+static uint8_t buffer[VENDOR_REQUESTS_DATA_OFFSET + VENDOR_REQUESTS_MAX_LENGTH] __attribute__((aligned(2)));
+
+//Result and time of the last bus transaction, sent by VENDOR_REQUEST_GET_BUS_STATUS
+static bus_status_t lastStatus = BUS_OK;
+static usb_timestamp_t lastStamp = {0, 0};
+
+//Parameters of the write waiting for its data stage
+static uint8_t writeTarget = 0;
+static uint8_t writeReg = 0;
+static uint8_t writeLength = 0;
+
+#if USB_VENDOR_STREAM_ENABLE
+//Register or command read into each stream packet, length 0 sends the header only
+static bool streamIsSPI = false;
+static uint8_t streamTarget = 0;
+static uint8_t streamReg = 0;
+static uint8_t streamLength = 0;
+#endif
+
+//Maps the result of a bus transaction to the control request status, errors stall the request
+static RETURN_CODE_t VendorRequests_Result(bus_status_t status)
+{
+    lastStatus = status;
+    SerialBus_GetTimestamp(&lastStamp);
+    return (status == BUS_OK) ? SUCCESS : UNSUPPORTED;
+}
+
+//Runs the I2C write once the data stage is received
+static RETURN_CODE_t VendorRequests_I2CWriteReceived(void)
+{
+    buffer[VENDOR_REQUESTS_DATA_OFFSET - 1] = writeReg;
+    return VendorRequests_Result(SerialBus_I2CWrite(writeTarget, &buffer[VENDOR_REQUESTS_DATA_OFFSET - 1], writeLength + 1));
+}
+
+//Runs the SPI write once the data stage is received
+static RETURN_CODE_t VendorRequests_SPIWriteReceived(void)
+{
+    SerialBus_SPIExchange((spi_target_t) writeTarget, &buffer[VENDOR_REQUESTS_DATA_OFFSET], writeLength);
+    return VendorRequests_Result(BUS_OK);
+}
+
+#if USB_VENDOR_STREAM_ENABLE
+//Reads the stream register once per frame, called by the vendor interface
+static uint8_t VendorRequests_StreamSample(uint8_t* data, uint8_t maxLength)
+{
+    usb_timestamp_t stamp;
+    uint8_t* sample = &data[1 + USB_TIMESTAMP_SIZE];
+    
+    if ((streamLength == 0) || ((1 + USB_TIMESTAMP_SIZE + streamLength) > maxLength))
+    {
+        return 0;
+    }
+
+    if (streamIsSPI)
+    {
+        //Command byte in the slot before the sample, then 0x00 while the response is clocked in
+        sample[-1] = streamReg;
+        for (uint8_t i = 0; i < streamLength; i++)
+        {
+            sample[i] = 0x00;
+        }
+        SerialBus_SPIExchange((spi_target_t) streamTarget, &sample[-1], streamLength + 1);
+        data[0] = (uint8_t) BUS_OK;
+    }
+    else
+    {
+        data[0] = (uint8_t) SerialBus_I2CWriteRead(streamTarget, &streamReg, 1, sample, streamLength);
+    }
+
+    //Written last, the SPI command byte overlaps the timestamp
+    SerialBus_GetTimestamp(&stamp);
+    USBTimestamp_Write(&stamp, &data[1]);
+
+    return 1 + USB_TIMESTAMP_SIZE + streamLength;
+}
+#endif
+
+//Handles the bus vendor requests, returns UNSUPPORTED to stall the request
+static RETURN_CODE_t VendorRequests_Handler(USB_SETUP_REQUEST_t* setupRequestPtr)
+{
+    uint8_t* data = &buffer[VENDOR_REQUESTS_DATA_OFFSET];
+    uint16_t length = setupRequestPtr->wLength;
+    uint16_t value = setupRequestPtr->wValue;
+    uint8_t index;
+    bool isIn = (setupRequestPtr->bmRequestType.dataPhaseTransferDirection == USB_REQUEST_DIR_IN);
+
+    if ((setupRequestPtr->bmRequestType.recipient != USB_REQUEST_RECIPIENT_DEVICE) || (length > VENDOR_REQUESTS_MAX_LENGTH))
+    {
+        return UNSUPPORTED;
+    }
+
+    switch (setupRequestPtr->bRequest)
+    {
+        case VENDOR_REQUEST_I2C_READ:
+        {
+            if ((!isIn) || (length == 0) || (value > 0x7F))
+            {
+                return UNSUPPORTED;
+            }
+
+            index = (uint8_t) setupRequestPtr->wIndex;
+            if (VendorRequests_Result(SerialBus_I2CWriteRead((uint8_t) value, &index, 1, data, (uint8_t) length)) != SUCCESS)
+            {
+                return UNSUPPORTED;
+            }
+            return USB_TransferControlDataSet(data, length, NULL);
+        }
+        case VENDOR_REQUEST_SPI_READ:
+        {
+            if ((!isIn) || (length == 0) || (value > SPI_TARGET_USD))
+            {
+                return UNSUPPORTED;
+            }
+
+            //Command byte, then 0x00 while the response is clocked in
+            data[-1] = (uint8_t) setupRequestPtr->wIndex;
+            for (uint8_t i = 0; i < length; i++)
+            {
+                data[i] = 0x00;
+            }
+            SerialBus_SPIExchange((spi_target_t) value, &data[-1], (uint8_t) (length + 1));
+            VendorRequests_Result(BUS_OK);
+            return USB_TransferControlDataSet(data, length, NULL);
+        }
+        case VENDOR_REQUEST_I2C_WRITE:
+        {
+            if ((isIn) || (value > 0x7F))
+            {
+                return UNSUPPORTED;
+            }
+
+            writeTarget = (uint8_t) value;
+            writeReg = (uint8_t) setupRequestPtr->wIndex;
+            writeLength = (uint8_t) length;
+
+            if (length == 0)
+            {
+                //No data stage, write the register address only
+                return VendorRequests_I2CWriteReceived();
+            }
+            return USB_TransferControlWriteSet(data, length, VendorRequests_I2CWriteReceived);
+        }
+        case VENDOR_REQUEST_SPI_WRITE:
+        {
+            if ((isIn) || (length == 0) || (value > SPI_TARGET_USD))
+            {
+                return UNSUPPORTED;
+            }
+
+            writeTarget = (uint8_t) value;
+            writeLength = (uint8_t) length;
+            return USB_TransferControlWriteSet(data, length, VendorRequests_SPIWriteReceived);
+        }
+#if USB_VENDOR_STREAM_ENABLE
+        case VENDOR_REQUEST_STREAM_I2C:
+        case VENDOR_REQUEST_STREAM_SPI:
+        {
+            bool isSPI = (setupRequestPtr->bRequest == VENDOR_REQUEST_STREAM_SPI);
+            
+            if ((isIn) || (length != 0) || (value > ((isSPI) ? SPI_TARGET_USD : 0x7F)) 
+                    || ((setupRequestPtr->wIndex >> 8) > VENDOR_REQUESTS_STREAM_MAX_LENGTH))
+            {
+                return UNSUPPORTED;
+            }
+
+            //Takes effect from the next frame
+            streamIsSPI = isSPI;
+            streamTarget = (uint8_t) value;
+            streamReg = (uint8_t) setupRequestPtr->wIndex;
+            streamLength = (uint8_t) (setupRequestPtr->wIndex >> 8);
+            return SUCCESS;
+        }
+#endif
+        case VENDOR_REQUEST_GET_STATS:
+        {
+            if ((!isIn) || (length == 0))
+            {
+                return UNSUPPORTED;
+            }
+
+            //Read only, the counters are not cleared
+            Stats_Write(data, false);
+            if (length > (STATS_COUNTERS * STATS_COUNTER_SIZE))
+            {
+                length = STATS_COUNTERS * STATS_COUNTER_SIZE;
+            }
+            return USB_TransferControlDataSet(data, length, NULL);
+        }
+        case VENDOR_REQUEST_GET_BUS_STATUS:
+        {
+            if ((!isIn) || (length == 0))
+            {
+                return UNSUPPORTED;
+            }
+
+            data[0] = (uint8_t) lastStatus;
+            if (length < (1 + USB_TIMESTAMP_SIZE))
+            {
+                //Status only, for hosts that read 1 byte
+                return USB_TransferControlDataSet(data, 1, NULL);
+            }
+
+            USBTimestamp_Write(&lastStamp, &data[1]);
+            return USB_TransferControlDataSet(data, 1 + USB_TIMESTAMP_SIZE, NULL);
+        }
+        default:
+        {
+            //Unknown request
+            return UNSUPPORTED;
+        }
+    }
+}
+
+void VendorRequests_Initialize(void)
+{
+#if USB_VENDOR_ENABLE
+    //The vendor interface passes on the requests it does not handle
+    USB_VendorApplicationRequestCallbackRegister(VendorRequests_Handler);
+#if USB_VENDOR_STREAM_ENABLE
+    USB_VendorStreamSampleCallbackRegister(VendorRequests_StreamSample);
+#endif
+#else
+    USB_VendorRequestCallbackRegister(VendorRequests_Handler);
+#endif
+}
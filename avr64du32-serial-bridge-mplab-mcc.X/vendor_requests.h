@@ -0,0 +1,37 @@
+#ifndef VENDOR_REQUESTS_H
+#define	VENDOR_REQUESTS_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Vendor control requests (bRequest), sent to the device recipient
+//Each request runs one bus transaction, a failed transaction stalls the request
+#define VENDOR_REQUEST_I2C_READ 0x10        //IN: wValue = address, wIndex = register, data = wLength bytes read from the register
+#define VENDOR_REQUEST_I2C_WRITE 0x11       //OUT: wValue = address, wIndex = register, data = bytes written after the register
+#define VENDOR_REQUEST_SPI_READ 0x12        //IN: wValue = SPI target, wIndex = command, data = wLength bytes clocked in after the command
+#define VENDOR_REQUEST_SPI_WRITE 0x13       //OUT: wValue = SPI target, data = bytes sent with one chip select
+#define VENDOR_REQUEST_STREAM_I2C 0x14      //OUT: wValue = address, wIndex = register | (length << 8), no data, length 0 stops sampling
+#define VENDOR_REQUEST_STREAM_SPI 0x15      //OUT: wValue = SPI target, wIndex = command | (length << 8), no data, length 0 stops sampling
+#define VENDOR_REQUEST_GET_STATS 0x1E       //IN: error counters (stats_counter_t order, 4 bytes each, LSB first), wLength may be shorter
+#define VENDOR_REQUEST_GET_BUS_STATUS 0x1F  //IN: bus_status_t of the last request, then its timestamp if wLength >= 5
+
+//Largest data stage, 1 control packet
+#define VENDOR_REQUESTS_MAX_LENGTH 64
+
+//Each stream packet carries the bus_status_t of the sample, its timestamp, then the bytes read
+//Largest sample, the stream packet data less the status and the timestamp
+#define VENDOR_REQUESTS_STREAM_MAX_LENGTH 54
+
+    //Routes the bus vendor requests to this module
+    void VendorRequests_Initialize(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* VENDOR_REQUESTS_H */
+
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Sends one bus request to the HID interface of the AVR64DU32 serial bridge.
+
+The request is written as a 64-byte output report and the response is read from
+the next input report. No driver needs to be installed.
+
+Usage: hid_request.py i2c-read|i2c-write|spi-read|spi-exchange <address or target> <register or command> <length or data bytes...>
+"""
+
+import struct
+import sys
+import time
+
+import hid
+
+VID = 0x04D8
+PID = 0x0B15
+REPORT_SIZE = 64
+OPERATIONS = {"i2c-read": 0x10, "i2c-write": 0x11, "spi-read": 0x12, "spi-exchange": 0x13}
+
+
+def main():
+    if len(sys.argv) < 4 or sys.argv[1] not in OPERATIONS:
+        sys.exit(__doc__)
+
+    operation = OPERATIONS[sys.argv[1]]
+    target = int(sys.argv[2], 16)
+    register = int(sys.argv[3], 16)
+    if operation in (0x10, 0x12):
+        data = b""
+        length = int(sys.argv[4]) if len(sys.argv) > 4 else 1
+    else:
+        data = bytes(int(b, 16) for b in sys.argv[4:])
+        length = len(data)
+
+    # The HID interface is the only HID collection of the device
+    path = next((d["path"] for d in hid.enumerate(VID, PID)), None)
+    if path is None:
+        sys.exit("Device not found")
+
+    dev = hid.device()
+    dev.open_path(path)
+
+    report = bytes([operation, target, register, length]) + data
+    start = time.perf_counter()
+    # Report ID 0, not sent on the bus
+    dev.write(b"\x00" + report.ljust(REPORT_SIZE, b"\x00"))
+    response = bytes(dev.read(REPORT_SIZE, 1000))
+    elapsed = time.perf_counter() - start
+    dev.close()
+
+    if len(response) < 7:
+        sys.exit("No response")
+
+    frame, offset = struct.unpack("<HH", response[3:7])
+    print("Status %d, %.2f ms round trip, completed in frame %d + %d us" % (response[1], elapsed * 1000, frame, offset))
+    if response[2]:
+        print("> " + response[7:7 + response[2]].hex(" ").upper())
+
+
+if __name__ == "__main__":
+    main()
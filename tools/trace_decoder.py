@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Reads the event trace of the AVR64DU32 serial bridge and prints it as a timeline.
+
+The trace command is sent on the serial port until the device returns no more events.
+Each event is 6 bytes: the CPU cycle count (4 bytes, MSB first), the event and its payload.
+Recording pauses while each trace command runs, only the USB transfers carrying it are recorded.
+
+Usage: trace_decoder.py <serial port> [CPU MHz]
+   or: trace_decoder.py - [CPU MHz] < saved responses of the trace command
+"""
+
+import sys
+
+import serial
+
+ENTRY_SIZE = 6
+BUS_STATUS = ["OK", "ADDR_NACK", "DATA_NACK", "ERROR", "NOT_READY", "COLLISION", "TIMEOUT", "STUCK"]
+COMMAND_STATUS = ["OK", "INVALID", "ADDR_NACK", "DATA_NACK", "NOT_READY", "POLL_TIMEOUT",
+                  "BUS_COLLISION", "BUS_TIMEOUT", "BUS_STUCK", "UART_CONFIG"]
+I2C_STATE = ["IDLE", "SEND_RD_ADDR", "SEND_WR_ADDR", "TX", "RX", "NACK", "ERROR", "STOP", "RESET"]
+
+
+def endpoint(payload):
+    return "EP%d %s" % (payload & 0x7F, "IN" if payload & 0x80 else "OUT")
+
+
+def name(table, value):
+    return table[value] if value < len(table) else "0x%02X" % value
+
+
+EVENTS = [
+    ("USB transfer start", endpoint),
+    ("USB transfer end", endpoint),
+    ("Buffer full", lambda p: "buffer 0x%02X" % p),
+    ("Buffer empty", lambda p: "buffer 0x%02X" % p),
+    ("I2C start", lambda p: "0x%02X %s" % (p >> 1, "read" if p & 0x01 else "write")),
+    ("I2C end", lambda p: name(BUS_STATUS, p)),
+    ("SPI start", lambda p: "target %d" % p),
+    ("SPI end", lambda p: "%d bytes" % p),
+    ("Command start", lambda p: "'%s'" % chr(p) if 0x20 <= p < 0x7F else "0x%02X" % p),
+    ("Command end", lambda p: name(COMMAND_STATUS, p)),
+    ("I2C state", lambda p: name(I2C_STATE, p)),
+]
+
+
+def parse(line):
+    """Returns the bytes of a '> XX XX ...' response, None for other lines."""
+    line = line.strip()
+    if not line.startswith(">"):
+        return None
+    return bytes(int(b, 16) for b in line[1:].split())
+
+
+def read_port(port):
+    data = bytes()
+    with serial.Serial(port, timeout=1) as ser:
+        while True:
+            ser.write(b"trace\n")
+            chunk = None
+            while chunk is None:
+                line = ser.readline().decode("ascii", "replace")
+                if not line:
+                    sys.exit("No response from the device")
+                chunk = parse(line)
+            if not chunk:
+                return data
+            data += chunk
+
+
+def read_file(stream):
+    data = bytes()
+    for line in stream:
+        chunk = parse(line)
+        if chunk:
+            data += chunk
+    return data
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+
+    mhz = float(sys.argv[2]) if len(sys.argv) > 2 else 24.0
+    data = read_file(sys.stdin) if sys.argv[1] == "-" else read_port(sys.argv[1])
+
+    start = None
+    previous = None
+    for i in range(0, len(data) - ENTRY_SIZE + 1, ENTRY_SIZE):
+        cycles = int.from_bytes(data[i:i + 4], "big")
+        event, payload = data[i + 4], data[i + 5]
+        if start is None:
+            start = previous = cycles
+
+        # The cycle count wraps around after 2^32 cycles, about 3 minutes at 24 MHz
+        time = ((cycles - start) & 0xFFFFFFFF) / mhz
+        delta = ((cycles - previous) & 0xFFFFFFFF) / mhz
+        previous = cycles
+
+        if event < len(EVENTS):
+            label, decode = EVENTS[event]
+            print("%12.1f us %+10.1f us  %-18s %s" % (time, delta, label, decode(payload)))
+        else:
+            print("%12.1f us %+10.1f us  Event 0x%02X        0x%02X" % (time, delta, event, payload))
+
+    if start is None:
+        print("Trace is empty")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,331 @@
+#!/usr/bin/env python3
+"""Host model of the UART bridge of the AVR64DU32 serial bridge, with TxD looped back to RxD.
+
+The host streams data into the data port. The bridge sends it on TxD, gets it back on RxD
+and returns it to the host, so both directions run at the line rate at the same time.
+The model steps the CPU one cycle at a time: the USART0 receive and data register empty
+interrupts, the USB and tick interrupts, and the scheduler tasks, each with the number of
+cycles its code path takes. Bytes are lost if the 2-byte receive FIFO or the 256-byte ring
+overflows. Data from the host is never lost, the OUT endpoint is held off instead.
+
+The cycle counts are estimates for the code at 24 MHz; the PROF command gives the measured
+time of the USB and application tasks (PROFILER_TASK) to check them against.
+
+Usage: uart_loopback.py [baud ...] [-t milliseconds]
+"""
+
+import sys
+
+F_CPU = 24000000
+FRAME_BITS = 10                 # 8N1
+
+# Interrupts (cycles): response, prologue and epilogue, then the loop body per byte
+RX_ISR_ENTRY = 30
+RX_ISR_PER_BYTE = 32
+DRE_ISR_ENTRY = 28
+DRE_ISR_PER_BYTE = 26
+USB_ISR = 80                    # Main_USBInterrupt, masks the USB interrupts but the SOF and posts an event
+SOF_ISR = 140                   # Main_USBBusEvent, anchors the timestamp and clears the SOF flag
+TICK_ISR = 90                   # TCB0, posts SCHEDULER_EVENT_TICK
+
+# Tasks (cycles)
+SCHEDULER_PASS = 60
+STATE_TASK = 150
+USB_TASK = 600                  # USBDevice_Handle and the class handlers with nothing to do
+USB_PACKET = 250                # Completing one transfer and starting the next
+USB_PER_BYTE = 45               # One CIRCBUF_Enqueue or CIRCBUF_Dequeue call per byte
+APP_TASK = 300                  # Text parser, text queue and HID bridge with nothing to do
+BRIDGE = 300                    # UARTBridge_Handle, line state and error reporting
+BRIDGE_CDC_PER_BYTE = 45        # CDC data port ReadBlock / WriteBlock, through CIRCBUF
+BRIDGE_RING_PER_BYTE = 10       # USART0_ReadBlock / USART0_WriteBlock
+
+# Buffers (bytes)
+RING_SIZE = 255                 # Usable space of the 256-byte USART0 rings
+CDC_RX_SIZE = 4 * 64            # USB_CDC_DATA_PORT_RX_QUEUE_PACKETS packets
+CDC_TX_SIZE = 128               # USB_CDC_TX_BUFFER_SIZE
+PACKET_SIZE = 64
+BLOCK_SIZE = 64                 # UART_BRIDGE_BLOCK_SIZE
+
+TICK_CYCLES = F_CPU // 1000
+
+EVENT_TICK = 0x08
+EVENT_USB = 0x01
+EVENT_USB_TX = 0x02
+EVENT_RX = 0x10
+EVENT_UART = 0x20
+EVENT_SOF = 0x40
+
+
+def packet_cycles(length):
+    """Full-speed bus time of a bulk transaction: token, data with bit stuffing, handshake."""
+    return int((80 + length * 8 * 1.17) * F_CPU / 12000000)
+
+
+class Model:
+    def __init__(self, baud):
+        self.byte_cycles = F_CPU * FRAME_BITS / baud
+
+        # USART0
+        self.tx_data = False
+        self.tx_shift_end = None
+        self.rx_fifo = 0
+        self.dreie = False
+        self.tx_ring = 0
+        self.rx_ring = 0
+
+        # CDC data port and USB
+        self.cdc_rx = 0
+        self.cdc_tx = 0
+        self.out_armed = True
+        self.in_length = 0
+        self.bus_end = None
+        self.bus_packet = None
+        self.last_in = False
+        self.completions = []
+        self.usb_flag = False
+        self.usb_masked = False
+        self.sof_flag = False
+        self.tick_flag = False
+
+        # Bridge
+        self.host_block = 0
+        self.host_offset = 0
+        self.events = 0
+
+        # Results
+        self.sent = 0
+        self.returned = 0
+        self.lost_fifo = 0
+        self.lost_ring = 0
+        self.idle = 0
+        self.isr_cycles = 0
+
+    # Code paths, each yields the cycles it takes, the effect follows
+
+    def rx_isr(self):
+        yield RX_ISR_ENTRY
+        while self.rx_fifo:
+            yield RX_ISR_PER_BYTE
+            self.rx_fifo -= 1
+            if self.rx_ring < RING_SIZE:
+                self.rx_ring += 1
+            else:
+                self.lost_ring += 1
+
+    def dre_isr(self):
+        yield DRE_ISR_ENTRY
+        while self.tx_ring and not self.tx_data:
+            yield DRE_ISR_PER_BYTE
+            self.tx_ring -= 1
+            self.tx_data = True
+        if not self.tx_ring:
+            self.dreie = False
+
+    def usb_isr(self, sof, usb):
+        yield (SOF_ISR if sof else 0) + (USB_ISR if usb else 0)
+        if sof:
+            self.events |= EVENT_SOF
+        if usb:
+            self.usb_masked = True
+            self.events |= EVENT_USB
+
+    def tick_isr(self):
+        yield TICK_ISR
+        self.events |= EVENT_TICK
+
+    def state_task(self):
+        yield STATE_TASK
+        self.events |= EVENT_UART
+
+    def usb_task(self, events):
+        yield USB_TASK
+        for packet in self.completions:
+            if packet == "OUT":
+                yield USB_PACKET + USB_PER_BYTE * PACKET_SIZE
+                self.cdc_rx += PACKET_SIZE
+            else:
+                yield USB_PACKET
+                self.in_length = 0
+        self.completions = []
+        if not self.out_armed and self.cdc_rx + PACKET_SIZE <= CDC_RX_SIZE:
+            yield USB_PACKET
+            self.out_armed = True
+        if self.in_length == 0 and self.cdc_tx:
+            length = min(PACKET_SIZE, self.cdc_tx)
+            yield USB_PACKET + USB_PER_BYTE * length
+            self.cdc_tx -= length
+            self.in_length = length
+        self.usb_masked = False
+        if events & EVENT_USB:
+            self.events |= EVENT_RX
+
+    def application_task(self):
+        yield APP_TASK + BRIDGE
+
+        # Host to USART
+        length = min(RING_SIZE - self.tx_ring, BLOCK_SIZE, self.cdc_rx)
+        if length:
+            yield (BRIDGE_CDC_PER_BYTE + BRIDGE_RING_PER_BYTE) * length
+            self.cdc_rx -= length
+            self.tx_ring += length
+            self.dreie = True
+        more = length == BLOCK_SIZE
+
+        # USART to host
+        if self.host_block == 0 and self.rx_ring:
+            length = min(self.rx_ring, BLOCK_SIZE)
+            yield BRIDGE_RING_PER_BYTE * length
+            self.rx_ring -= length
+            self.host_block = length
+            self.host_offset = 0
+        length = min(self.host_block - self.host_offset, CDC_TX_SIZE - self.cdc_tx)
+        if length:
+            yield BRIDGE_CDC_PER_BYTE * length
+            self.host_offset += length
+            self.cdc_tx += length
+            if self.host_offset == self.host_block:
+                more = more or self.host_block == BLOCK_SIZE
+                self.host_block = 0
+
+        # A full block may have more data behind it
+        if more:
+            self.events |= EVENT_UART
+        self.events |= EVENT_USB_TX
+
+    def main_loop(self):
+        while True:
+            if not self.events:
+                # Sleeping until the next interrupt
+                self.idle += 1
+                yield 1
+                continue
+            yield SCHEDULER_PASS
+            if self.events & EVENT_TICK:
+                self.events &= ~EVENT_TICK
+                yield from self.state_task()
+            elif self.events & (EVENT_USB | EVENT_USB_TX | EVENT_SOF):
+                events = self.events & (EVENT_USB | EVENT_USB_TX | EVENT_SOF)
+                self.events &= ~events
+                yield from self.usb_task(events)
+            elif self.events & (EVENT_RX | EVENT_UART):
+                self.events &= ~(EVENT_RX | EVENT_UART)
+                yield from self.application_task()
+
+    # Hardware
+
+    def line(self, now):
+        if self.tx_shift_end is not None and now >= self.tx_shift_end:
+            # TxD is wired to RxD, the frame arrives in the receive FIFO as it ends
+            self.tx_shift_end = None
+            if self.rx_fifo < 2:
+                self.rx_fifo += 1
+            else:
+                self.lost_fifo += 1
+        if self.tx_shift_end is None and self.tx_data:
+            self.tx_data = False
+            self.tx_shift_end = now + self.byte_cycles
+
+    def bus(self, now):
+        if self.bus_end is not None:
+            if now < self.bus_end:
+                return
+            self.completions.append(self.bus_packet)
+            if self.bus_packet == "IN":
+                self.returned += self.in_length
+            else:
+                self.sent += PACKET_SIZE
+            self.usb_flag = True
+            self.bus_end = None
+
+        # The host keeps an OUT transfer queued and polls the IN endpoint, taking turns
+        start_in = self.in_length and "IN" not in self.completions
+        start_out = self.out_armed
+        if start_in and (self.last_in is False or not start_out):
+            self.bus_packet = "IN"
+            self.bus_end = now + packet_cycles(self.in_length)
+            self.last_in = True
+        elif start_out:
+            self.out_armed = False
+            self.bus_packet = "OUT"
+            self.bus_end = now + packet_cycles(PACKET_SIZE)
+            self.last_in = False
+
+    def pending_isr(self):
+        # Lowest vector first: USB, TCB0, then USART0 RXC and DRE
+        # The SOF stays unmasked while the stack runs
+        usb = self.usb_flag and not self.usb_masked
+        if self.sof_flag or usb:
+            sof = self.sof_flag
+            self.sof_flag = False
+            if usb:
+                self.usb_flag = False
+            return self.usb_isr(sof, usb)
+        if self.tick_flag:
+            self.tick_flag = False
+            return self.tick_isr()
+        if self.rx_fifo:
+            return self.rx_isr()
+        if self.dreie and not self.tx_data:
+            return self.dre_isr()
+        return None
+
+    def run(self, cycles):
+        main = self.main_loop()
+        main_left = next(main)
+        isr = None
+        isr_left = 0
+        for now in range(cycles):
+            self.line(now)
+            self.bus(now)
+            if now % TICK_CYCLES == 0:
+                self.tick_flag = True
+                self.sof_flag = True
+
+            # Interrupts don't nest, the main loop only runs between them
+            if isr is None:
+                isr = self.pending_isr()
+                if isr is not None:
+                    isr_left = next(isr)
+            if isr is not None:
+                self.isr_cycles += 1
+                isr_left -= 1
+                if isr_left == 0:
+                    isr_left = next(isr, None)
+                    if isr_left is None:
+                        isr = None
+                continue
+
+            main_left -= 1
+            if main_left == 0:
+                main_left = next(main)
+
+
+def main():
+    args = sys.argv[1:]
+    milliseconds = 50
+    if "-t" in args:
+        i = args.index("-t")
+        milliseconds = int(args[i + 1])
+        del args[i:i + 2]
+    rates = [int(float(a)) for a in args] or [115200, 500000, 1000000, 1500000, 2000000, 3000000]
+
+    print("%10s %12s %12s %8s %8s %6s %6s" % ("baud", "line kB/s", "looped kB/s", "lost", "ISR %", "idle %", "ok"))
+    for baud in rates:
+        model = Model(baud)
+        cycles = F_CPU * milliseconds // 1000
+        model.run(cycles)
+
+        seconds = cycles / F_CPU
+        line_rate = baud / FRAME_BITS
+        looped = model.returned / seconds
+        lost = model.lost_fifo + model.lost_ring
+
+        # Sustained: nothing lost, and the line kept busy once the pipeline has filled
+        sustained = lost == 0 and looped >= 0.95 * line_rate
+        print("%10d %12.1f %12.1f %8d %8.1f %6.1f %6s" % (
+            baud, line_rate / 1000, looped / 1000, lost,
+            100.0 * model.isr_cycles / cycles, 100.0 * model.idle / cycles, "yes" if sustained else "no"))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Measures the throughput of the vendor interface loopback of the AVR64DU32 serial bridge.
+
+Data is written to the bulk OUT endpoint and read back from the bulk IN endpoint,
+and compared. The counters of the device are read with vendor request 0x01 at the end.
+Each write waits for its data to come back, so the result is a lower bound for clients
+that keep several transfers queued.
+
+Usage: vendor_loopback.py [seconds] [transfer size]
+"""
+
+import os
+import struct
+import sys
+import time
+
+import usb.core
+import usb.util
+
+VID = 0x04D8
+PID = 0x0B15
+INTERFACE = 2
+EP_OUT = 0x03
+EP_IN = 0x83
+REQUEST_GET_LOOPBACK_STATISTICS = 0x01
+
+
+def main():
+    seconds = float(sys.argv[1]) if len(sys.argv) > 1 else 5.0
+    size = int(sys.argv[2]) if len(sys.argv) > 2 else 512
+
+    # The device holds two 256-byte transfers until they are read back, and only ends
+    # an OUT transfer early on a short packet
+    if size > 512 or (size % 64 == 0 and size % 256 != 0):
+        sys.exit("Transfer size must be 256, 512, or up to 512 and not a multiple of 64")
+
+    dev = usb.core.find(idVendor=VID, idProduct=PID)
+    if dev is None:
+        sys.exit("Device not found")
+
+    usb.util.claim_interface(dev, INTERFACE)
+
+    # Clear the device counters
+    dev.ctrl_transfer(0xC0, REQUEST_GET_LOOPBACK_STATISTICS, 1, 0, 10)
+
+    total = 0
+    start = time.monotonic()
+    while time.monotonic() - start < seconds:
+        data = os.urandom(size)
+        dev.write(EP_OUT, data)
+        echo = bytes()
+        while len(echo) < size:
+            echo += bytes(dev.read(EP_IN, size - len(echo), timeout=1000))
+        if echo != data:
+            sys.exit("Loopback data mismatch after %d bytes" % total)
+        total += size
+    elapsed = time.monotonic() - start
+
+    received, transmitted, transfers = struct.unpack("<IIH", bytes(dev.ctrl_transfer(0xC0, REQUEST_GET_LOOPBACK_STATISTICS, 0, 0, 10)))
+
+    print("%d bytes looped back in %.2f s, %.1f kB/s each way" % (total, elapsed, total / elapsed / 1000))
+    print("Device: %d bytes received, %d bytes sent back, %d OUT transfers" % (received, transmitted, transfers))
+
+    usb.util.release_interface(dev, INTERFACE)
+
+
+if __name__ == "__main__":
+    main()
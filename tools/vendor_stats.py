@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+"""Prints the error counters of the AVR64DU32 serial bridge.
+
+The counters are read with vendor control request 0x1E on EP0, so the serial port
+and the other interfaces are not disturbed. They are never cleared by the device,
+run the tool twice and compare to see what changed in between.
+
+Usage: vendor_stats.py
+"""
+
+import struct
+import sys
+
+import usb.core
+
+VID = 0x04D8
+PID = 0x0B15
+REQUEST_GET_STATS = 0x1E
+COUNTERS = [
+    "Serial port bytes dropped",
+    "Data port bytes dropped",
+    "Response characters dropped",
+    "USB overflows/underflows",
+    "I2C address NACKs",
+    "I2C data NACKs",
+    "I2C bus collisions",
+    "I2C timeouts",
+]
+
+
+def main():
+    dev = usb.core.find(idVendor=VID, idProduct=PID)
+    if dev is None:
+        sys.exit("Device not found")
+
+    data = bytes(dev.ctrl_transfer(0xC0, REQUEST_GET_STATS, 0, 0, 4 * len(COUNTERS)))
+    values = struct.unpack("<%dI" % (len(data) // 4), data)
+
+    for name, value in zip(COUNTERS, values):
+        print("%-28s %d" % (name, value))
+
+
+if __name__ == "__main__":
+    main()
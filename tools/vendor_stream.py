@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Reads the isochronous stream of the vendor interface of the AVR64DU32 serial bridge.
+
+Selects alternate setting 1 of the vendor interface, sets the sampled register with
+vendor request 0x14 (I2C) or 0x15 (SPI) and reads one packet per frame. Gaps in the
+sequence numbers are frames in which the device did not send a packet. The timestamp
+of each sample gives the delay from the Start-of-Frame to the end of the bus transaction.
+
+Usage: vendor_stream.py i2c|spi <address or target> <register or command> <length> [seconds]
+"""
+
+import struct
+import sys
+import time
+
+import usb.core
+import usb.util
+
+VID = 0x04D8
+PID = 0x0B15
+INTERFACE = 2
+ALTERNATE_STREAM = 1
+EP_STREAM = 0x86
+PACKET_SIZE = 64
+REQUEST_STREAM_I2C = 0x14
+REQUEST_STREAM_SPI = 0x15
+
+
+def main():
+    if len(sys.argv) < 5 or sys.argv[1] not in ("i2c", "spi"):
+        sys.exit(__doc__)
+
+    request = REQUEST_STREAM_I2C if sys.argv[1] == "i2c" else REQUEST_STREAM_SPI
+    target = int(sys.argv[2], 16)
+    register = int(sys.argv[3], 16)
+    length = int(sys.argv[4])
+    seconds = float(sys.argv[5]) if len(sys.argv) > 5 else 5.0
+
+    dev = usb.core.find(idVendor=VID, idProduct=PID)
+    if dev is None:
+        sys.exit("Device not found")
+
+    usb.util.claim_interface(dev, INTERFACE)
+    dev.ctrl_transfer(0x40, request, target, register | (length << 8), None)
+    dev.set_interface_altsetting(INTERFACE, ALTERNATE_STREAM)
+
+    packets = 0
+    missed = 0
+    errors = 0
+    delays = []
+    last = None
+    start = time.monotonic()
+    while time.monotonic() - start < seconds:
+        data = bytes(dev.read(EP_STREAM, PACKET_SIZE, timeout=100))
+        if len(data) < 4:
+            continue
+        sequence, frame = struct.unpack("<HH", data[:4])
+        if last is not None:
+            missed += ((sequence - last) & 0xFFFF) - 1
+        last = sequence
+        if length and len(data) >= 9:
+            if data[4] != 0:
+                errors += 1
+            sample_frame, offset = struct.unpack("<HH", data[5:9])
+            delays.append(((sample_frame - frame) & 0x7FF) * 1000 + offset)
+        packets += 1
+    elapsed = time.monotonic() - start
+
+    dev.set_interface_altsetting(INTERFACE, 0)
+    usb.util.release_interface(dev, INTERFACE)
+
+    print("%d packets in %.2f s, %.0f samples/s" % (packets, elapsed, packets / elapsed))
+    print("%d frames missed, %d bus errors" % (missed, errors))
+    if delays:
+        print("Sample delay after SOF: %d us min, %d us avg, %d us max" % (min(delays), sum(delays) / len(delays), max(delays)))
+    if packets:
+        print("Last sample: %s" % data[9:].hex(" "))
+
+
+if __name__ == "__main__":
+    main()